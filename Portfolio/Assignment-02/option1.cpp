@@ -11,10 +11,14 @@
 #include "SharedLib.h"
 #include "LinkedList.hpp"
 #include "MergeSort.hpp"
+#include "QuickSort.hpp"
+#include "RadixTrie.hpp"
+#include "TopK.hpp"
 
 namespace
 {
 constexpr int kEmployeeCount = 1500;
+constexpr int kSampleSize = 8;
 
 struct ManifestContext
 {
@@ -56,31 +60,9 @@ int CompareByCabin(const TPerson& lhs, const TPerson& rhs)
 	return CompareByName(lhs, rhs);
 }
 
-int PartitionByCabin(std::vector<TPerson>& people, int low, int high)
+bool QuickCompareByCabin(const TPerson lhs, const TPerson rhs)
 {
-	TPerson pivot = people[high];
-	int i = low;
-	for (int j = low; j < high; ++j)
-	{
-		if (CompareByCabin(people[j], pivot) <= 0)
-		{
-			std::swap(people[i], people[j]);
-			++i;
-		}
-	}
-	std::swap(people[i], people[high]);
-	return i;
-}
-
-void QuickSortByCabin(std::vector<TPerson>& people, int low, int high)
-{
-	if (low >= high)
-	{
-		return;
-	}
-	int pivotIndex = PartitionByCabin(people, low, high);
-	QuickSortByCabin(people, low, pivotIndex - 1);
-	QuickSortByCabin(people, pivotIndex + 1, high);
+	return CompareByCabin(lhs, rhs) <= 0;
 }
 
 int BinarySearchGuest(const std::vector<TPerson>& guests, const std::string& first, const std::string& last)
@@ -126,16 +108,52 @@ std::vector<TPerson> CopyListToVector(TLinkedList<TPerson>& list)
 	return result;
 }
 
+void PrintPerson(const TPerson& person)
+{
+	std::cout << "  " << person.lastName << ", " << person.firstName
+		<< " - " << StatusToString(person.status)
+		<< " - cabin " << person.cabinSize << std::endl;
+}
+
+// Trie key for a person: "Last, First", so a prefix of the last name finds everyone with it
+std::string NameKey(const TPerson& person)
+{
+	return person.lastName + ", " + person.firstName;
+}
+
+// Prints up to kSampleSize guests whose "Last, First" name starts with prefix
+void PrintNamePrefixMatches(const TRadixTrie<int>& names, const std::vector<TPerson>& guests, const std::string& prefix)
+{
+	std::cout << "Guests starting with \"" << prefix << "\":" << std::endl;
+	int shown = names.ForEachWithPrefix(prefix, kSampleSize, [&guests](const std::string&, const int& index)
+		{
+			PrintPerson(guests[static_cast<std::size_t>(index)]);
+			return true;
+		});
+	if (shown == 0)
+	{
+		std::cout << "  (none)" << std::endl;
+	}
+}
+
 void PrintSample(const std::vector<TPerson>& list, const std::string& title)
 {
 	std::cout << title << " (" << list.size() << ")" << std::endl;
-	const std::size_t limit = std::min<std::size_t>(list.size(), 8);
+	const std::size_t limit = std::min<std::size_t>(list.size(), kSampleSize);
 	for (std::size_t i = 0; i < limit; ++i)
 	{
-		const TPerson& person = list[i];
-		std::cout << "  " << person.lastName << ", " << person.firstName
-			<< " - " << StatusToString(person.status)
-			<< " - cabin " << person.cabinSize << std::endl;
+		PrintPerson(list[i]);
+	}
+}
+
+// Prints the first kSampleSize entries of an array whose head has already been put in order
+void PrintSample(const TArrayWrapper<TPerson>& sample, int totalCount, const std::string& title)
+{
+	std::cout << title << " (" << totalCount << ")" << std::endl;
+	const int limit = std::min(sample.GetCount(), kSampleSize);
+	for (int i = 0; i < limit; ++i)
+	{
+		PrintPerson(sample[i]);
 	}
 }
 
@@ -196,24 +214,39 @@ int RunApp()
 	std::cout << "Employees: " << context.employees.GetCount() << std::endl;
 	std::cout << "Guests:    " << context.guests.GetCount() << std::endl;
 
-	TMergeSort<TPerson>::Sort(&context.employees, MergeCompareByName);
-	TMergeSort<TPerson>::Sort(&context.guests, MergeCompareByName);
+	// Employees are only sampled, so keep the first few instead of sorting the whole list
+	TArrayWrapper<TPerson> employeeSample(kSampleSize);
+	TTopK<TPerson>::Select(&context.employees, kSampleSize, MergeCompareByName, &employeeSample);
+	PrintSample(employeeSample, context.employees.GetCount(), "Employees (alphabetical)");
 
-	std::vector<TPerson> employees = CopyListToVector(context.employees);
+	// Guests need the full order for the binary search below
+	TMergeSort<TPerson>::Sort(&context.guests, MergeCompareByName);
 	std::vector<TPerson> guests = CopyListToVector(context.guests);
-	PrintSample(employees, "Employees (alphabetical)");
 	PrintSample(guests, "Guests (alphabetical)");
 
 	if (!guests.empty())
 	{
-		std::vector<TPerson> cabins = guests;
-		QuickSortByCabin(cabins, 0, static_cast<int>(cabins.size()) - 1);
-		PrintSample(cabins, "Guests (cabin grouping)");
+		TArrayWrapper<TPerson> cabins(static_cast<int>(guests.size()));
+		for (const TPerson& guest : guests)
+		{
+			cabins.Add(guest);
+		}
+		TQuickSort<TPerson>::PartialSort(&cabins, kSampleSize, QuickCompareByCabin);
+		PrintSample(cabins, cabins.GetCount(), "Guests (cabin grouping)");
 
 		const TPerson& lookupTarget = guests[guests.size() / 2];
 		int foundIndex = BinarySearchGuest(guests, lookupTarget.firstName, lookupTarget.lastName);
 		std::cout << "Lookup sample: " << lookupTarget.firstName << " " << lookupTarget.lastName
 			<< (foundIndex >= 0 ? " found." : " not found.") << std::endl;
+
+		// Exact names are not always known: index them for lookups by the start of the name
+		TRadixTrie<int> guestNames;
+		for (std::size_t i = 0; i < guests.size(); ++i)
+		{
+			guestNames.Insert(NameKey(guests[i]), static_cast<int>(i));
+		}
+		const std::string prefix = lookupTarget.lastName.substr(0, 3);
+		PrintNamePrefixMatches(guestNames, guests, prefix);
 	}
 	else
 	{
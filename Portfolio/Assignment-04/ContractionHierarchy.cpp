@@ -0,0 +1,621 @@
+#include "ContractionHierarchy.h"
+#include "PriorityQueue.hpp"
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <limits>
+#include <utility>
+
+// --- Hierarchy file layout: header, ranks, upward CSR, downward CSR ---
+static const char kHierarchyMagic[4] = { 'C', 'H', 'X', '1' };
+static constexpr uint32_t kHierarchyVersion = 1;
+
+struct THierarchyHeader
+{
+	char magic[4];
+	uint32_t version;
+	uint32_t vertexCount;
+	uint32_t edgeCount;
+	uint32_t upEdgeCount;
+	uint32_t downEdgeCount;
+	uint64_t adjacencyHash;
+};
+
+template <typename T>
+static void WriteArray(std::ofstream& aFile, const TArrayWrapper<T>& aArray)
+{
+	aFile.write(reinterpret_cast<const char*>(aArray.GetData()), static_cast<std::streamsize>(sizeof(T) * aArray.GetCount()));
+}
+
+template <typename T>
+static bool ReadArray(std::ifstream& aFile, TArrayWrapper<T>& aArray, uint32_t aCount)
+{
+	aArray.Clear();
+	aArray.Resize(static_cast<int>(aCount));
+	aFile.read(reinterpret_cast<char*>(aArray.GetData()), static_cast<std::streamsize>(sizeof(T) * aCount));
+	return aFile.good();
+}
+
+// One direction of a loaded hierarchy: offsets start at 0, never decrease and end at the edge count, every
+// edge leads to a higher rank than the vertex it is stored at, and a shortcut's middle vertex ranks below both
+// ends (-1 = an original edge). Unpack relies on the ranks to terminate.
+static bool IsValidDirection(const TArrayWrapper<uint32_t>& aOffsets, const TArrayWrapper<uint32_t>& aNeighbours,
+	const TArrayWrapper<int32_t>& aMiddles, const TArrayWrapper<uint32_t>& aRanks, uint32_t aVertexCount)
+{
+	if (aOffsets[0] != 0 || aOffsets[aVertexCount] != static_cast<uint32_t>(aNeighbours.GetCount()))
+	{
+		return false;
+	}
+	for (uint32_t v = 0; v < aVertexCount; v++)
+	{
+		if (aOffsets[v] > aOffsets[v + 1])
+		{
+			return false;
+		}
+		for (uint32_t e = aOffsets[v]; e < aOffsets[v + 1]; e++)
+		{
+			uint32_t neighbour = aNeighbours[e];
+			int32_t middle = aMiddles[e];
+			if (neighbour >= aVertexCount || aRanks[neighbour] <= aRanks[v]
+				|| middle < -1 || middle >= static_cast<int64_t>(aVertexCount))
+			{
+				return false;
+			}
+			if (middle >= 0 && aRanks[middle] >= aRanks[v])
+			{
+				return false;
+			}
+		}
+	}
+	return true;
+}
+
+TContractionHierarchy::TContractionHierarchy()
+	: vertexCount(0), edgeCount(0), adjacencyHash(0)
+{
+}
+
+void TContractionHierarchy::Clear()
+{
+	vertexCount = 0;
+	edgeCount = 0;
+	adjacencyHash = 0;
+	ranks.Clear();
+	upOffsets.Clear();
+	upTargets.Clear();
+	upWeights.Clear();
+	upMiddles.Clear();
+	downOffsets.Clear();
+	downSources.Clear();
+	downWeights.Clear();
+	downMiddles.Clear();
+}
+
+bool TContractionHierarchy::AddOrImprove(TArrayWrapper<TArc>& aArcs, int aVertex, float aWeight, int aMiddle)
+{
+	for (TArc& arc : aArcs)
+	{
+		if (arc.vertex == aVertex)
+		{
+			if (!(aWeight < arc.weight))
+			{
+				return false;
+			}
+			arc.weight = aWeight;
+			arc.middle = aMiddle;
+			return true;
+		}
+	}
+	aArcs.Add(TArc{ aVertex, aWeight, aMiddle });
+	return true;
+}
+
+void TContractionHierarchy::RemoveArc(TArrayWrapper<TArc>& aArcs, int aVertex)
+{
+	for (int i = 0; i < aArcs.GetCount(); i++)
+	{
+		if (aArcs[i].vertex == aVertex)
+		{
+			// Order does not matter, so the last arc fills the gap
+			aArcs[i] = aArcs[aArcs.GetCount() - 1];
+			aArcs.RemoveLast();
+			return;
+		}
+	}
+}
+
+int TContractionHierarchy::Contract(int aVertex, TArrayWrapper<TArrayWrapper<TArc>>& aOut, TArrayWrapper<TArrayWrapper<TArc>>& aIn,
+	TQueryContext& aWitness, bool aIsSimulation) const
+{
+	TArrayWrapper<TArc>& incoming = aIn[aVertex];
+	TArrayWrapper<TArc>& outgoing = aOut[aVertex];
+	float maxOutgoing = 0.0f;
+	for (const TArc& arc : outgoing)
+	{
+		if (arc.weight > maxOutgoing)
+		{
+			maxOutgoing = arc.weight;
+		}
+	}
+
+	// Shortcuts are collected first, so every witness search sees the graph as it was before the contraction
+	struct TShortcut { int from; int to; float weight; };
+	TArrayWrapper<TShortcut> shortcuts;
+	TIndexedPriorityQueue<TQueryContext::kHeapArity>& pq = aWitness.GetHeap();
+
+	for (const TArc& in : incoming)
+	{
+		int u = in.vertex;
+		if (outgoing.IsEmpty())
+		{
+			break;
+		}
+
+		// 1. Local Dijkstra from u that avoids aVertex, until it has settled every out-neighbour or passed the longest path through aVertex
+		float limit = in.weight + maxOutgoing;
+		aWitness.Begin(vertexCount, u);
+		aWitness.SetLabel(u, 0.0f, -1);
+		pq.Enqueue(u, 0.0f);
+		for (const TArc& out : outgoing)
+		{
+			aWitness.AddTarget(out.vertex);
+		}
+		int settledCount = 0;
+		while (!pq.IsEmpty() && !aWitness.AllTargetsSettled() && pq.PeekPriority() <= limit && settledCount < (aIsSimulation ? kPriorityWitnessSettleLimit : kWitnessSettleLimit))
+		{
+			int x = pq.Dequeue();
+			aWitness.Settle(x);
+			settledCount++;
+			float distanceOfX = aWitness.GetDistance(x);
+			const TArc* arcs = aOut.GetData()[x].GetData();
+			int arcCount = aOut.GetData()[x].GetCount();
+			for (int i = 0; i < arcCount; i++)
+			{
+				int y = arcs[i].vertex;
+				float distanceThroughX = distanceOfX + arcs[i].weight;
+				if (y == aVertex || distanceThroughX > limit)
+				{
+					continue;
+				}
+				if (!aWitness.IsReached(y))
+				{
+					aWitness.SetLabel(y, distanceThroughX, x);
+					pq.Enqueue(y, distanceThroughX);
+				}
+				else if (!aWitness.IsSettled(y) && distanceThroughX < aWitness.GetDistance(y))
+				{
+					aWitness.SetLabel(y, distanceThroughX, x);
+					pq.DecreaseKey(y, distanceThroughX);
+				}
+			}
+		}
+
+		// 2. u -> aVertex -> w needs a shortcut unless some path found above is at least as short
+		for (const TArc& out : outgoing)
+		{
+			float viaVertex = in.weight + out.weight;
+			if (out.vertex != u && aWitness.GetDistance(out.vertex) > viaVertex)
+			{
+				shortcuts.Add(TShortcut{ u, out.vertex, viaVertex });
+			}
+		}
+	}
+
+	if (aIsSimulation)
+	{
+		return shortcuts.GetCount();
+	}
+
+	// 3. Take aVertex out of the remaining graph and link its neighbours directly
+	for (const TArc& in : incoming)
+	{
+		RemoveArc(aOut[in.vertex], aVertex);
+	}
+	for (const TArc& out : outgoing)
+	{
+		RemoveArc(aIn[out.vertex], aVertex);
+	}
+	for (const TShortcut& shortcut : shortcuts)
+	{
+		if (AddOrImprove(aOut[shortcut.from], shortcut.to, shortcut.weight, aVertex))
+		{
+			AddOrImprove(aIn[shortcut.to], shortcut.from, shortcut.weight, aVertex);
+		}
+	}
+	return shortcuts.GetCount();
+}
+
+int TContractionHierarchy::Priority(int aVertex, TArrayWrapper<TArrayWrapper<TArc>>& aOut, TArrayWrapper<TArrayWrapper<TArc>>& aIn,
+	const TArrayWrapper<int>& aContractedNeighbours, const TArrayWrapper<int>& aLevels, TQueryContext& aWitness) const
+{
+	int shortcuts = Contract(aVertex, aOut, aIn, aWitness, true);
+	int removed = aOut[aVertex].GetCount() + aIn[aVertex].GetCount();
+	return 2 * (shortcuts - removed) + aContractedNeighbours[aVertex] + aLevels[aVertex];
+}
+
+void TContractionHierarchy::Build(TGraph& aGraph)
+{
+	Clear();
+	TAdjacencyView adjacency = aGraph.GetAdjacency();
+	vertexCount = adjacency.vertexCount;
+	edgeCount = adjacency.edgeCount;
+	adjacencyHash = adjacency.ComputeHash();
+
+	// 1. Remaining graph as per-vertex arc lists (parallel edges merged, self-loops dropped)
+	TArrayWrapper<TArrayWrapper<TArc>> out(vertexCount);
+	TArrayWrapper<TArrayWrapper<TArc>> in(vertexCount);
+	for (int v = 0; v < vertexCount; v++)
+	{
+		out.Emplace();
+		in.Emplace();
+	}
+	for (int u = 0; u < vertexCount; u++)
+	{
+		for (uint32_t e = adjacency.offsets[u]; e < adjacency.offsets[u + 1]; e++)
+		{
+			int v = static_cast<int>(adjacency.targets[e]);
+			if (v != u && AddOrImprove(out[u], v, adjacency.weights[e], -1))
+			{
+				AddOrImprove(in[v], u, adjacency.weights[e], -1);
+			}
+		}
+	}
+
+	// 2. Initial priorities
+	TQueryContext witness;
+	TArrayWrapper<int> contractedNeighbours;
+	contractedNeighbours.Resize(vertexCount, 0);
+	TArrayWrapper<int> levels;
+	levels.Resize(vertexCount, 0);
+	TPriorityQueue<int, 4> order(vertexCount);
+	for (int v = 0; v < vertexCount; v++)
+	{
+		order.Enqueue(v, static_cast<float>(Priority(v, out, in, contractedNeighbours, levels, witness)));
+	}
+
+	// 3. Contract in priority order. Priorities only change around a contracted vertex, so instead of
+	// updating all its neighbours, a popped vertex is re-evaluated (lazy update) and put back if it is no longer the cheapest.
+	TArrayWrapper<TArrayWrapper<TArc>> upArcs(vertexCount);
+	TArrayWrapper<TArrayWrapper<TArc>> downArcs(vertexCount);
+	for (int v = 0; v < vertexCount; v++)
+	{
+		upArcs.Emplace();
+		downArcs.Emplace();
+	}
+	TArrayWrapper<int> updatedBy;
+	updatedBy.Resize(vertexCount, -1);
+	ranks.Resize(vertexCount, 0);
+	uint32_t nextRank = 0;
+	while (!order.IsEmpty())
+	{
+		int v = order.Dequeue();
+		int priority = Priority(v, out, in, contractedNeighbours, levels, witness);
+		if (!order.IsEmpty() && static_cast<float>(priority) > order.PeekPriority())
+		{
+			order.Enqueue(v, static_cast<float>(priority));
+			continue;
+		}
+
+		Contract(v, out, in, witness, false);
+		ranks[v] = nextRank++;
+		// Whatever is still linked to v is contracted later, so ranks higher: these are v's upward and downward edges
+		upArcs[v] = std::move(out[v]);
+		downArcs[v] = std::move(in[v]);
+
+		for (int side = 0; side < 2; side++)
+		{
+			for (const TArc& arc : (side == 0) ? upArcs[v] : downArcs[v])
+			{
+				int neighbour = arc.vertex;
+				if (updatedBy[neighbour] == v)
+				{
+					continue; // Linked both ways, already counted
+				}
+				updatedBy[neighbour] = v;
+				contractedNeighbours[neighbour]++;
+				if (levels[neighbour] < levels[v] + 1)
+				{
+					levels[neighbour] = levels[v] + 1;
+				}
+			}
+		}
+	}
+
+	// 4. Pack both directions into CSR arrays
+	upOffsets.Resize(vertexCount + 1, 0);
+	downOffsets.Resize(vertexCount + 1, 0);
+	for (int v = 0; v < vertexCount; v++)
+	{
+		upOffsets[v + 1] = upOffsets[v] + static_cast<uint32_t>(upArcs[v].GetCount());
+		downOffsets[v + 1] = downOffsets[v] + static_cast<uint32_t>(downArcs[v].GetCount());
+		for (const TArc& arc : upArcs[v])
+		{
+			upTargets.Add(static_cast<uint32_t>(arc.vertex));
+			upWeights.Add(arc.weight);
+			upMiddles.Add(arc.middle);
+		}
+		for (const TArc& arc : downArcs[v])
+		{
+			downSources.Add(static_cast<uint32_t>(arc.vertex));
+			downWeights.Add(arc.weight);
+			downMiddles.Add(arc.middle);
+		}
+	}
+}
+
+int TContractionHierarchy::GetShortcutCount() const
+{
+	int shortcuts = 0;
+	for (int32_t middle : upMiddles)
+	{
+		shortcuts += (middle >= 0) ? 1 : 0;
+	}
+	for (int32_t middle : downMiddles)
+	{
+		shortcuts += (middle >= 0) ? 1 : 0;
+	}
+	return shortcuts;
+}
+
+bool TContractionHierarchy::Save(const std::string& aFilename) const
+{
+	if (IsEmpty())
+	{
+		std::cerr << "Error: Build the contraction hierarchy before saving it." << std::endl;
+		return false;
+	}
+	std::ofstream file(aFilename, std::ios::binary | std::ios::trunc);
+	if (!file.is_open())
+	{
+		return false;
+	}
+
+	THierarchyHeader header;
+	std::memcpy(header.magic, kHierarchyMagic, sizeof(kHierarchyMagic));
+	header.version = kHierarchyVersion;
+	header.vertexCount = static_cast<uint32_t>(vertexCount);
+	header.edgeCount = static_cast<uint32_t>(edgeCount);
+	header.upEdgeCount = static_cast<uint32_t>(upTargets.GetCount());
+	header.downEdgeCount = static_cast<uint32_t>(downSources.GetCount());
+	header.adjacencyHash = adjacencyHash;
+	file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+	WriteArray(file, ranks);
+	WriteArray(file, upOffsets);
+	WriteArray(file, upTargets);
+	WriteArray(file, upWeights);
+	WriteArray(file, upMiddles);
+	WriteArray(file, downOffsets);
+	WriteArray(file, downSources);
+	WriteArray(file, downWeights);
+	WriteArray(file, downMiddles);
+	return file.good();
+}
+
+bool TContractionHierarchy::Load(const std::string& aFilename, TGraph& aGraph)
+{
+	Clear();
+	std::ifstream file(aFilename, std::ios::binary);
+	if (!file.is_open())
+	{
+		return false;
+	}
+
+	THierarchyHeader header;
+	TAdjacencyView adjacency = aGraph.GetAdjacency();
+	bool valid = static_cast<bool>(file.read(reinterpret_cast<char*>(&header), sizeof(header)))
+		&& std::memcmp(header.magic, kHierarchyMagic, sizeof(kHierarchyMagic)) == 0
+		&& header.version == kHierarchyVersion
+		&& header.vertexCount == static_cast<uint32_t>(adjacency.vertexCount)
+		&& header.edgeCount == static_cast<uint32_t>(adjacency.edgeCount)
+		&& header.adjacencyHash == adjacency.ComputeHash();
+
+	// The counts must describe exactly the bytes of the file, so a damaged header cannot make the reads allocate
+	// more than the file holds
+	if (valid)
+	{
+		std::streamoff dataStart = file.tellg();
+		file.seekg(0, std::ios::end);
+		uint64_t dataSize = static_cast<uint64_t>(file.tellg() - dataStart);
+		file.seekg(dataStart);
+		uint64_t vertexBytes = sizeof(uint32_t) * (3 * static_cast<uint64_t>(header.vertexCount) + 2);
+		uint64_t edgeBytes = (sizeof(uint32_t) + sizeof(float) + sizeof(int32_t))
+			* (static_cast<uint64_t>(header.upEdgeCount) + header.downEdgeCount);
+		valid = dataSize == vertexBytes + edgeBytes;
+	}
+	valid = valid
+		&& ReadArray(file, ranks, header.vertexCount)
+		&& ReadArray(file, upOffsets, header.vertexCount + 1)
+		&& ReadArray(file, upTargets, header.upEdgeCount)
+		&& ReadArray(file, upWeights, header.upEdgeCount)
+		&& ReadArray(file, upMiddles, header.upEdgeCount)
+		&& ReadArray(file, downOffsets, header.vertexCount + 1)
+		&& ReadArray(file, downSources, header.downEdgeCount)
+		&& ReadArray(file, downWeights, header.downEdgeCount)
+		&& ReadArray(file, downMiddles, header.downEdgeCount);
+	// The ranks are a contraction order, so each position is taken exactly once
+	if (valid)
+	{
+		std::vector<uint8_t> isRankTaken(header.vertexCount, 0);
+		for (uint32_t v = 0; v < header.vertexCount && valid; v++)
+		{
+			valid = ranks[v] < header.vertexCount && isRankTaken[ranks[v]] == 0;
+			if (valid) isRankTaken[ranks[v]] = 1;
+		}
+	}
+	valid = valid
+		&& IsValidDirection(upOffsets, upTargets, upMiddles, ranks, header.vertexCount)
+		&& IsValidDirection(downOffsets, downSources, downMiddles, ranks, header.vertexCount);
+	if (!valid)
+	{
+		Clear();
+		return false;
+	}
+
+	vertexCount = static_cast<int>(header.vertexCount);
+	edgeCount = static_cast<int>(header.edgeCount);
+	adjacencyHash = header.adjacencyHash;
+	return true;
+}
+
+bool TContractionHierarchy::FindEdge(int aFrom, int aTo, float& aOutWeight, int& aOutMiddle) const
+{
+	bool isUpward = ranks[aTo] > ranks[aFrom];
+	int at = isUpward ? aFrom : aTo;
+	int other = isUpward ? aTo : aFrom;
+	const TArrayWrapper<uint32_t>& offsets = isUpward ? upOffsets : downOffsets;
+	const TArrayWrapper<uint32_t>& neighbours = isUpward ? upTargets : downSources;
+	for (uint32_t e = offsets[at]; e < offsets[at + 1]; e++)
+	{
+		if (static_cast<int>(neighbours[e]) == other)
+		{
+			aOutWeight = isUpward ? upWeights[e] : downWeights[e];
+			aOutMiddle = isUpward ? upMiddles[e] : downMiddles[e];
+			return true;
+		}
+	}
+	return false;
+}
+
+bool TContractionHierarchy::Unpack(int aFrom, int aTo, std::vector<int>& aOutVertices, float& aCost) const
+{
+	// A shortcut from -> to via m stands for from -> m, m -> to; unpack left to right with an explicit stack
+	TArrayWrapper<std::pair<int, int>> stack;
+	stack.Add(std::make_pair(aFrom, aTo));
+	while (!stack.IsEmpty())
+	{
+		std::pair<int, int> edge = stack.RemoveLast();
+		float weight = 0.0f;
+		int middle = -1;
+		if (!FindEdge(edge.first, edge.second, weight, middle))
+		{
+			return false;
+		}
+		if (middle < 0)
+		{
+			aOutVertices.push_back(edge.second);
+			aCost += weight;
+		}
+		else
+		{
+			stack.Add(std::make_pair(middle, edge.second));
+			stack.Add(std::make_pair(edge.first, middle));
+		}
+	}
+	return true;
+}
+
+bool TContractionHierarchy::Query(int aStartId, int aTargetId, TQueryContext& aContext, std::vector<int>& aOutVertices, float& aOutCost) const
+{
+	aOutVertices.clear();
+	aOutCost = std::numeric_limits<float>::infinity();
+	if (aStartId < 0 || aStartId >= vertexCount || aTargetId < 0 || aTargetId >= vertexCount)
+	{
+		return false;
+	}
+
+	// 1. Upward searches from both ends
+	TQueryContext& forward = aContext;
+	TQueryContext& backward = aContext.GetBackward();
+	forward.Begin(vertexCount, aStartId);
+	backward.Begin(vertexCount, aTargetId);
+	forward.SetLabel(aStartId, 0.0f, -1);
+	backward.SetLabel(aTargetId, 0.0f, -1);
+	forward.GetHeap().Enqueue(aStartId, 0.0f);
+	backward.GetHeap().Enqueue(aTargetId, 0.0f);
+
+	float best = std::numeric_limits<float>::infinity();
+	int meet = -1;
+
+	// 2. A side stops once its smallest key cannot beat the best meeting; alternate by smaller key
+	while (true)
+	{
+		TIndexedPriorityQueue<TQueryContext::kHeapArity>& forwardQueue = forward.GetHeap();
+		TIndexedPriorityQueue<TQueryContext::kHeapArity>& backwardQueue = backward.GetHeap();
+		bool isForwardOpen = !forwardQueue.IsEmpty() && forwardQueue.PeekPriority() < best;
+		bool isBackwardOpen = !backwardQueue.IsEmpty() && backwardQueue.PeekPriority() < best;
+		if (!isForwardOpen && !isBackwardOpen)
+		{
+			break;
+		}
+		bool isForward = isForwardOpen && (!isBackwardOpen || forwardQueue.PeekPriority() <= backwardQueue.PeekPriority());
+		TQueryContext& side = isForward ? forward : backward;
+		const TQueryContext& other = isForward ? backward : forward;
+		TIndexedPriorityQueue<TQueryContext::kHeapArity>& pq = isForward ? forwardQueue : backwardQueue;
+		const uint32_t* offsets = isForward ? upOffsets.GetData() : downOffsets.GetData();
+		const uint32_t* neighbours = isForward ? upTargets.GetData() : downSources.GetData();
+		const float* weights = isForward ? upWeights.GetData() : downWeights.GetData();
+
+		int u = pq.Dequeue();
+		side.Settle(u);
+		float distanceOfU = side.GetDistance(u);
+		if (other.IsReached(u) && distanceOfU + other.GetDistance(u) < best)
+		{
+			best = distanceOfU + other.GetDistance(u);
+			meet = u;
+		}
+
+		// Stall-on-demand: if a higher vertex this side already reached gets to u more cheaply
+		// (over an edge of the opposite direction), u's label is not a shortest distance and u need not be expanded
+		const uint32_t* stallOffsets = isForward ? downOffsets.GetData() : upOffsets.GetData();
+		const uint32_t* stallNeighbours = isForward ? downSources.GetData() : upTargets.GetData();
+		const float* stallWeights = isForward ? downWeights.GetData() : upWeights.GetData();
+		bool isStalled = false;
+		for (uint32_t e = stallOffsets[u]; e < stallOffsets[u + 1] && !isStalled; e++)
+		{
+			int x = static_cast<int>(stallNeighbours[e]);
+			isStalled = side.IsReached(x) && side.GetDistance(x) + stallWeights[e] < distanceOfU;
+		}
+		if (isStalled)
+		{
+			continue;
+		}
+
+		for (uint32_t e = offsets[u]; e < offsets[u + 1]; e++)
+		{
+			int v = static_cast<int>(neighbours[e]);
+			float distanceThroughU = distanceOfU + weights[e];
+			if (!side.IsSettled(v) && distanceThroughU < side.GetDistance(v))
+			{
+				side.SetLabel(v, distanceThroughU, u);
+				if (pq.Contains(v))
+				{
+					pq.DecreaseKey(v, distanceThroughU);
+				}
+				else
+				{
+					pq.Enqueue(v, distanceThroughU);
+				}
+			}
+		}
+	}
+
+	if (meet < 0)
+	{
+		return false;
+	}
+
+	// 3. Hierarchy path start -> meet -> target, then every edge unpacked. The weights are re-added
+	// in path order, so the cost matches a plain Dijkstra over the same path exactly.
+	std::vector<int> upPath;
+	for (int v = meet; v >= 0; v = forward.GetParent(v))
+	{
+		upPath.push_back(v);
+	}
+	aOutVertices.push_back(aStartId);
+	aOutCost = 0.0f;
+	bool isComplete = true;
+	for (std::size_t i = upPath.size() - 1; i > 0 && isComplete; i--)
+	{
+		isComplete = Unpack(upPath[i], upPath[i - 1], aOutVertices, aOutCost);
+	}
+	for (int v = meet; backward.GetParent(v) >= 0 && isComplete; v = backward.GetParent(v))
+	{
+		isComplete = Unpack(v, backward.GetParent(v), aOutVertices, aOutCost);
+	}
+	if (!isComplete)
+	{
+		aOutVertices.clear();
+		aOutCost = std::numeric_limits<float>::infinity();
+	}
+	return isComplete;
+}
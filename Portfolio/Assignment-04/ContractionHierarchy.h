@@ -0,0 +1,126 @@
+#pragma once
+#ifndef CONTRACTION_HIERARCHY_H
+#define CONTRACTION_HIERARCHY_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "ArrayWrapper.hpp"
+#include "Graph.h"
+
+/**
+ * @brief Contraction Hierarchy over a TGraph, for point-to-point queries that settle a few hundred
+ * vertices instead of a large part of the graph.
+ *
+ * Build contracts the vertices one by one in order of importance (edge difference plus contracted
+ * neighbours and level, updated lazily). Contracting v removes it from the graph; for every pair of neighbours
+ * u -> v -> w whose shortest path runs through v (no witness path found by a bounded local search),
+ * a shortcut u -> w remembering v is inserted. Every edge then points either up or down in the
+ * contraction order, and a shortest path climbs up from the start and down to the destination.
+ * Query runs two Dijkstra searches that only go up: forward from the start over the upward edges,
+ * backward from the destination over the downward ones. Shortcuts are unpacked into original edges.
+ *
+ * Vertex ids are those of the graph, so queries use ordinary TQueryContexts.
+ */
+class TContractionHierarchy {
+public:
+	// A local witness search gives up after settling this many vertices (a shortcut is added instead)
+	static constexpr int kWitnessSettleLimit = 500;
+	// Smaller limit for the searches that only estimate a priority; a few extra shortcuts counted only affect the order
+	static constexpr int kPriorityWitnessSettleLimit = 50;
+
+private:
+	// An edge of the remaining graph during Build; middle is the contracted vertex of a shortcut, -1 for an original edge
+	struct TArc {
+		int vertex;
+		float weight;
+		int middle;
+	};
+
+	int vertexCount;
+	int edgeCount;          // Edges of the graph it was built from
+	uint64_t adjacencyHash; // Hash of that graph's CSR, checked by Load
+	TArrayWrapper<uint32_t> ranks; // Vertex id -> position in the contraction order
+
+	// Upward CSR: edges v -> w with rank[w] > rank[v], at v
+	TArrayWrapper<uint32_t> upOffsets;
+	TArrayWrapper<uint32_t> upTargets;
+	TArrayWrapper<float> upWeights;
+	TArrayWrapper<int32_t> upMiddles;
+	// Downward CSR: edges u -> v with rank[u] > rank[v], stored at v, so the backward search can follow them from v to u
+	TArrayWrapper<uint32_t> downOffsets;
+	TArrayWrapper<uint32_t> downSources;
+	TArrayWrapper<float> downWeights;
+	TArrayWrapper<int32_t> downMiddles;
+
+	/**
+	 * @brief Adds aArc to aArcs, or lowers the weight of the arc to the same vertex if aArc is cheaper.
+	 * @return False if an arc at least as cheap was already there.
+	 */
+	static bool AddOrImprove(TArrayWrapper<TArc>& aArcs, int aVertex, float aWeight, int aMiddle);
+
+	static void RemoveArc(TArrayWrapper<TArc>& aArcs, int aVertex);
+
+	/**
+	 * @brief Contracts aVertex out of the remaining graph, or with aIsSimulation only counts the shortcuts it would need.
+	 */
+	int Contract(int aVertex, TArrayWrapper<TArrayWrapper<TArc>>& aOut, TArrayWrapper<TArrayWrapper<TArc>>& aIn,
+		TQueryContext& aWitness, bool aIsSimulation) const;
+
+	/**
+	 * @brief Contraction priority (lower goes first): twice the edge difference (shortcuts added minus edges removed)
+	 * of contracting aVertex now, plus its contracted neighbours and its level, which spread the contraction evenly.
+	 */
+	int Priority(int aVertex, TArrayWrapper<TArrayWrapper<TArc>>& aOut, TArrayWrapper<TArrayWrapper<TArc>>& aIn,
+		const TArrayWrapper<int>& aContractedNeighbours, const TArrayWrapper<int>& aLevels, TQueryContext& aWitness) const;
+
+	/**
+	 * @brief Finds the hierarchy edge aFrom -> aTo (in the upward CSR of aFrom or the downward CSR of aTo).
+	 */
+	bool FindEdge(int aFrom, int aTo, float& aOutWeight, int& aOutMiddle) const;
+
+	/**
+	 * @brief Appends the original vertices after aFrom up to aTo, and adds their edge weights to aCost.
+	 * @return False if an edge of the hierarchy is missing (the path is then incomplete).
+	 */
+	bool Unpack(int aFrom, int aTo, std::vector<int>& aOutVertices, float& aCost) const;
+
+	void Clear();
+
+public:
+	TContractionHierarchy();
+
+	/**
+	 * @brief Contracts the whole graph (freezes the adjacency first). Replaces any previous hierarchy.
+	 */
+	void Build(TGraph& aGraph);
+
+	/**
+	 * @brief Writes the hierarchy to a binary file, so later runs can Load it instead of contracting again.
+	 */
+	bool Save(const std::string& aFilename) const;
+
+	/**
+	 * @brief Reads a hierarchy written by Save. Fails (and leaves this one empty) if it was built for a different graph
+	 * or the file is truncated or damaged (sizes that do not match the file, offsets out of order, ids out of range,
+	 * edges or shortcut middles that break the rank order).
+	 */
+	bool Load(const std::string& aFilename, TGraph& aGraph);
+
+	bool IsEmpty() const { return vertexCount == 0; }
+	int GetVertexCount() const { return vertexCount; }
+
+	/**
+	 * @brief Shortcuts added by the contraction (hierarchy edges minus the original ones).
+	 */
+	int GetShortcutCount() const;
+
+	/**
+	 * @brief Shortest route from aStartId to aTargetId. Uses aContext and its backward context.
+	 * @param aOutVertices Receives the full path (shortcuts unpacked), empty if unreachable.
+	 * @return False if the target cannot be reached (or a shortcut cannot be unpacked).
+	 */
+	bool Query(int aStartId, int aTargetId, TQueryContext& aContext, std::vector<int>& aOutVertices, float& aOutCost) const;
+};
+
+#endif // CONTRACTION_HIERARCHY_H
@@ -0,0 +1,441 @@
+#include "DistanceMatrix.h"
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <limits>
+#include <numeric>
+
+// --- Matrix file layout: header, float distances[V * V], then int32 nextHops[V * V] if flagged ---
+static const char kMatrixMagic[4] = { 'A', 'P', 'S', 'P' };
+static constexpr uint32_t kMatrixVersion = 1;
+static constexpr uint32_t kMatrixHasNextHops = 1;
+
+// Up to this many vertices Print shows the whole table
+static constexpr int kPrintTableMaxVertices = 12;
+
+struct TMatrixHeader
+{
+	char magic[4];
+	uint32_t version;
+	uint32_t vertexCount;
+	uint32_t flags;
+	uint64_t adjacencyHash;
+};
+
+/**
+ * @brief Prints aText right-aligned in aWidth columns, cut to aWidth - 1 characters.
+ * Counts UTF-8 characters rather than bytes, so names like "Ålesund" line up too.
+ */
+static void PrintCell(const std::string& aText, int aWidth)
+{
+	std::size_t end = 0;
+	int characters = 0;
+	while (end < aText.size() && characters < aWidth - 1)
+	{
+		end++;
+		// Continuation bytes (10xxxxxx) belong to the character before them
+		while (end < aText.size() && (static_cast<unsigned char>(aText[end]) & 0xC0) == 0x80)
+		{
+			end++;
+		}
+		characters++;
+	}
+	std::cout << std::string(static_cast<std::size_t>(aWidth - characters), ' ') << aText.substr(0, end);
+}
+
+TDistanceMatrix::TDistanceMatrix()
+	: vertexCount(0), hasNextHops(false), method(EAllPairsMethod::Auto),
+	distanceStorage(0, false, true), distances(nullptr), nextHops(nullptr), adjacencyHash(0)
+{
+}
+
+void TDistanceMatrix::Clear()
+{
+	matrixFile.Close();
+	distanceStorage.Clear();
+	distanceStorage.ShrinkToFit();
+	nextHopStorage.Clear();
+	nextHopStorage.ShrinkToFit();
+	distances = nullptr;
+	nextHops = nullptr;
+	vertexCount = 0;
+	hasNextHops = false;
+	method = EAllPairsMethod::Auto;
+	adjacencyHash = 0;
+}
+
+bool TDistanceMatrix::Build(TGraph& aGraph, bool aWithNextHops, int aThreadCount, EAllPairsMethod aMethod)
+{
+	Clear();
+	TAdjacencyView adjacency = aGraph.GetAdjacency();
+	if (adjacency.vertexCount > kMaxVertices)
+	{
+		std::cerr << "Error: " << adjacency.vertexCount << " vertices is too many for a distance matrix (max "
+			<< kMaxVertices << ")." << std::endl;
+		return false;
+	}
+
+	vertexCount = adjacency.vertexCount;
+	hasNextHops = aWithNextHops;
+	adjacencyHash = adjacency.ComputeHash();
+	std::size_t cellCount = static_cast<std::size_t>(vertexCount) * vertexCount;
+	distanceStorage.Resize(static_cast<int>(cellCount), std::numeric_limits<float>::infinity());
+	if (hasNextHops)
+	{
+		nextHopStorage.Resize(static_cast<int>(cellCount), kNoHop);
+	}
+	distances = distanceStorage.GetData();
+	nextHops = hasNextHops ? nextHopStorage.GetData() : nullptr;
+
+	if (aMethod == EAllPairsMethod::Auto)
+	{
+		bool isDense = static_cast<long long>(adjacency.edgeCount) * kDenseDivisor >= static_cast<long long>(vertexCount) * vertexCount;
+		aMethod = (vertexCount <= kFloydWarshallMaxVertices && isDense) ? EAllPairsMethod::FloydWarshall : EAllPairsMethod::Dijkstra;
+	}
+	method = aMethod;
+
+	TThreadPool pool(aThreadCount);
+	if (method == EAllPairsMethod::FloydWarshall)
+	{
+		BuildWithFloydWarshall(adjacency, pool);
+	}
+	else
+	{
+		BuildWithDijkstra(aGraph, pool);
+	}
+	return true;
+}
+
+void TDistanceMatrix::BuildWithDijkstra(TGraph& aGraph, TThreadPool& aPool)
+{
+	// Each source writes only its own row, so the threads share nothing but the (read-only) graph
+	std::vector<TQueryContext> contexts(static_cast<std::size_t>(aPool.GetThreadCount()));
+	std::vector<std::vector<int>> stacks(static_cast<std::size_t>(aPool.GetThreadCount()));
+	const TGraph& graph = aGraph;
+	float* distanceData = distanceStorage.GetData();
+	int32_t* hopData = nextHopStorage.GetData();
+
+	aPool.ParallelFor(vertexCount, [&](int aSource, int aThreadIndex)
+	{
+		TQueryContext& context = contexts[static_cast<std::size_t>(aThreadIndex)];
+		graph.RunDijkstra(graph.GetVertexName(aSource), context);
+
+		std::size_t rowStart = static_cast<std::size_t>(aSource) * vertexCount;
+		float* row = distanceData + rowStart;
+		for (int to = 0; to < vertexCount; to++)
+		{
+			row[to] = context.GetDistance(to);
+		}
+		if (!hasNextHops)
+		{
+			return;
+		}
+
+		// Next hop of v = the vertex below the source on v's parent chain. Walk each chain only
+		// until a vertex whose hop is known, then hand that hop down the walked part.
+		const int32_t kUnknown = -2;
+		int32_t* hops = hopData + rowStart;
+		for (int to = 0; to < vertexCount; to++)
+		{
+			hops[to] = context.IsReached(to) ? kUnknown : kNoHop;
+		}
+		hops[aSource] = aSource;
+		std::vector<int>& walked = stacks[static_cast<std::size_t>(aThreadIndex)];
+		for (int to = 0; to < vertexCount; to++)
+		{
+			walked.clear();
+			int v = to;
+			while (hops[v] == kUnknown)
+			{
+				int parent = context.GetParent(v);
+				if (parent == aSource)
+				{
+					hops[v] = v;
+					break;
+				}
+				walked.push_back(v);
+				v = parent;
+			}
+			for (int w : walked)
+			{
+				hops[w] = hops[v];
+			}
+		}
+	});
+}
+
+void TDistanceMatrix::RelaxTile(int aRowTile, int aColumnTile, int aPivotTile)
+{
+	float* d = distanceStorage.GetData();
+	int32_t* next = hasNextHops ? nextHopStorage.GetData() : nullptr;
+	std::size_t n = static_cast<std::size_t>(vertexCount);
+	int rowEnd = (aRowTile + 1) * kTileSize < vertexCount ? (aRowTile + 1) * kTileSize : vertexCount;
+	int columnStart = aColumnTile * kTileSize;
+	int columnEnd = columnStart + kTileSize < vertexCount ? columnStart + kTileSize : vertexCount;
+	int pivotEnd = (aPivotTile + 1) * kTileSize < vertexCount ? (aPivotTile + 1) * kTileSize : vertexCount;
+
+	// k stays the outer loop, so a tile that contains its own pivots (diagonal, pivot row or column) is still exact
+	for (int k = aPivotTile * kTileSize; k < pivotEnd; k++)
+	{
+		const float* pivotRow = d + k * n;
+		for (int i = aRowTile * kTileSize; i < rowEnd; i++)
+		{
+			float* row = d + i * n;
+			float viaPivot = row[k];
+			if (viaPivot == std::numeric_limits<float>::infinity())
+			{
+				continue;
+			}
+			// Branch-free inner loops (selects instead of ifs), so the compiler can vectorise them
+			if (next == nullptr)
+			{
+				for (int j = columnStart; j < columnEnd; j++)
+				{
+					float candidate = viaPivot + pivotRow[j];
+					row[j] = candidate < row[j] ? candidate : row[j];
+				}
+			}
+			else
+			{
+				int32_t* hopRow = next + i * n;
+				int32_t hopViaPivot = hopRow[k];
+				for (int j = columnStart; j < columnEnd; j++)
+				{
+					float candidate = viaPivot + pivotRow[j];
+					bool isShorter = candidate < row[j];
+					row[j] = isShorter ? candidate : row[j];
+					hopRow[j] = isShorter ? hopViaPivot : hopRow[j];
+				}
+			}
+		}
+	}
+}
+
+void TDistanceMatrix::BuildWithFloydWarshall(const TAdjacencyView& aAdjacency, TThreadPool& aPool)
+{
+	// 1. Start from the direct edges (the cheapest of parallel edges)
+	float* d = distanceStorage.GetData();
+	int32_t* next = hasNextHops ? nextHopStorage.GetData() : nullptr;
+	std::size_t n = static_cast<std::size_t>(vertexCount);
+	for (int u = 0; u < vertexCount; u++)
+	{
+		d[u * n + u] = 0.0f;
+		if (hasNextHops)
+		{
+			next[u * n + u] = u;
+		}
+		for (uint32_t e = aAdjacency.offsets[u]; e < aAdjacency.offsets[u + 1]; e++)
+		{
+			int v = static_cast<int>(aAdjacency.targets[e]);
+			if (aAdjacency.weights[e] < d[u * n + v])
+			{
+				d[u * n + v] = aAdjacency.weights[e];
+				if (hasNextHops)
+				{
+					next[u * n + v] = v;
+				}
+			}
+		}
+	}
+
+	// 2. One round per pivot tile. Tiles in the pivot's row and column depend only on the diagonal tile,
+	// and every other tile only on its row and column tile, so each phase runs in parallel.
+	int tileCount = (vertexCount + kTileSize - 1) / kTileSize;
+	for (int pivot = 0; pivot < tileCount; pivot++)
+	{
+		RelaxTile(pivot, pivot, pivot);
+
+		aPool.ParallelFor(2 * tileCount, [&](int aIndex, int)
+		{
+			int other = aIndex % tileCount;
+			if (other == pivot)
+			{
+				return;
+			}
+			if (aIndex < tileCount)
+			{
+				RelaxTile(pivot, other, pivot);
+			}
+			else
+			{
+				RelaxTile(other, pivot, pivot);
+			}
+		});
+
+		aPool.ParallelFor(tileCount * tileCount, [&](int aIndex, int)
+		{
+			int rowTile = aIndex / tileCount;
+			int columnTile = aIndex % tileCount;
+			if (rowTile != pivot && columnTile != pivot)
+			{
+				RelaxTile(rowTile, columnTile, pivot);
+			}
+		});
+	}
+}
+
+bool TDistanceMatrix::Save(const std::string& aFilename) const
+{
+	if (IsEmpty())
+	{
+		std::cerr << "Error: Build the distance matrix before saving it." << std::endl;
+		return false;
+	}
+	std::ofstream file(aFilename, std::ios::binary | std::ios::trunc);
+	if (!file.is_open())
+	{
+		return false;
+	}
+
+	TMatrixHeader header;
+	std::memcpy(header.magic, kMatrixMagic, sizeof(kMatrixMagic));
+	header.version = kMatrixVersion;
+	header.vertexCount = static_cast<uint32_t>(vertexCount);
+	header.flags = hasNextHops ? kMatrixHasNextHops : 0;
+	header.adjacencyHash = adjacencyHash;
+	file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+
+	std::size_t cellCount = static_cast<std::size_t>(vertexCount) * vertexCount;
+	file.write(reinterpret_cast<const char*>(distances), static_cast<std::streamsize>(sizeof(float) * cellCount));
+	if (hasNextHops)
+	{
+		file.write(reinterpret_cast<const char*>(nextHops), static_cast<std::streamsize>(sizeof(int32_t) * cellCount));
+	}
+	return file.good();
+}
+
+uint64_t TDistanceMatrix::GetFileSize() const
+{
+	uint64_t cellCount = static_cast<uint64_t>(vertexCount) * static_cast<uint64_t>(vertexCount);
+	return sizeof(TMatrixHeader) + cellCount * (sizeof(float) + (hasNextHops ? sizeof(int32_t) : 0));
+}
+
+bool TDistanceMatrix::Open(const std::string& aFilename, TGraph& aGraph)
+{
+	Clear();
+	if (!matrixFile.Open(aFilename))
+	{
+		return false;
+	}
+
+	TMatrixHeader header;
+	TAdjacencyView adjacency = aGraph.GetAdjacency();
+	const unsigned char* data = matrixFile.GetData();
+	std::size_t size = matrixFile.GetSize();
+	bool valid = size >= sizeof(header);
+	if (valid)
+	{
+		std::memcpy(&header, data, sizeof(header));
+		valid = std::memcmp(header.magic, kMatrixMagic, sizeof(kMatrixMagic)) == 0
+			&& header.version == kMatrixVersion
+			&& header.vertexCount == static_cast<uint32_t>(adjacency.vertexCount)
+			&& header.adjacencyHash == adjacency.ComputeHash();
+	}
+	std::size_t cellCount = static_cast<std::size_t>(adjacency.vertexCount) * adjacency.vertexCount;
+	bool withNextHops = valid && (header.flags & kMatrixHasNextHops) != 0;
+	std::size_t expectedSize = sizeof(header) + cellCount * (sizeof(float) + (withNextHops ? sizeof(int32_t) : 0));
+	if (!valid || size < expectedSize)
+	{
+		matrixFile.Close();
+		return false;
+	}
+
+	vertexCount = adjacency.vertexCount;
+	hasNextHops = withNextHops;
+	adjacencyHash = header.adjacencyHash;
+	distances = reinterpret_cast<const float*>(data + sizeof(header));
+	nextHops = hasNextHops ? reinterpret_cast<const int32_t*>(data + sizeof(header) + sizeof(float) * cellCount) : nullptr;
+	return true;
+}
+
+bool TDistanceMatrix::GetPath(int aFrom, int aTo, std::vector<int>& aOutVertices) const
+{
+	aOutVertices.clear();
+	if (!hasNextHops || aFrom < 0 || aFrom >= vertexCount || aTo < 0 || aTo >= vertexCount || GetNextHop(aFrom, aTo) == kNoHop)
+	{
+		return false;
+	}
+
+	// The hops may come from a mapped file: a hop outside the graph, or more hops than a simple path
+	// has, means it is damaged
+	aOutVertices.push_back(aFrom);
+	int v = aFrom;
+	for (int step = 0; v != aTo && step < vertexCount; step++)
+	{
+		v = GetNextHop(v, aTo);
+		if (v < 0 || v >= vertexCount)
+		{
+			aOutVertices.clear();
+			return false;
+		}
+		aOutVertices.push_back(v);
+	}
+	if (v != aTo)
+	{
+		aOutVertices.clear();
+		return false;
+	}
+	return true;
+}
+
+void TDistanceMatrix::Print(const TGraph& aGraph) const
+{
+	std::cout << "\n--- All-Pairs Routing Matrix (" << vertexCount << " x " << vertexCount << ") ---\n";
+
+	// Cities in the order of the graph file, whatever numbering the graph uses
+	std::vector<int> ids(static_cast<std::size_t>(vertexCount));
+	std::iota(ids.begin(), ids.end(), 0);
+	std::sort(ids.begin(), ids.end(), [&aGraph](int aLeft, int aRight) { return aGraph.GetInputIndex(aLeft) < aGraph.GetInputIndex(aRight); });
+
+	if (vertexCount <= kPrintTableMaxVertices)
+	{
+		// Rows are sources, columns destinations
+		const int kColumnWidth = 10;
+		PrintCell("From\\To", kColumnWidth);
+		for (int to : ids)
+		{
+			PrintCell(aGraph.GetVertexName(to), kColumnWidth);
+		}
+		std::cout << "\n";
+		for (int from : ids)
+		{
+			PrintCell(aGraph.GetVertexName(from), kColumnWidth);
+			for (int to : ids)
+			{
+				float distance = GetDistance(from, to);
+				if (distance == std::numeric_limits<float>::infinity())
+				{
+					std::cout << std::setw(kColumnWidth) << "-";
+				}
+				else
+				{
+					std::cout << std::setw(kColumnWidth) << distance;
+				}
+			}
+			std::cout << "\n";
+		}
+	}
+	else
+	{
+		// Too wide for a table: how far each source reaches
+		for (int from : ids)
+		{
+			int reachable = 0;
+			float farthest = 0.0f;
+			for (int to = 0; to < vertexCount; to++)
+			{
+				float distance = GetDistance(from, to);
+				if (distance != std::numeric_limits<float>::infinity())
+				{
+					reachable++;
+					farthest = (distance > farthest) ? distance : farthest;
+				}
+			}
+			std::cout << "Source: " << aGraph.GetVertexName(from) << " | Reachable: " << reachable
+				<< " | Farthest Cost: " << farthest << std::endl;
+		}
+	}
+	std::cout << "-----------------------------------------------\n";
+}
@@ -0,0 +1,130 @@
+#pragma once
+#ifndef DISTANCE_MATRIX_H
+#define DISTANCE_MATRIX_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "ArrayWrapper.hpp"
+#include "MappedFile.h"
+#include "ThreadPool.h"
+#include "Graph.h"
+
+/**
+ * @brief How TDistanceMatrix::Build computes all pairs.
+ * Dijkstra runs one search per source, spread over a thread pool (O(V * E log V), good for sparse graphs).
+ * FloydWarshall relaxes the whole matrix in cache-sized tiles (O(V^3), good for small dense graphs).
+ * Auto picks Floyd-Warshall for small graphs with many edges per vertex.
+ */
+enum class EAllPairsMethod {
+	Auto,
+	Dijkstra,
+	FloydWarshall
+};
+
+/**
+ * @brief All-pairs shortest path costs of a graph as a V x V matrix, with an optional next-hop matrix.
+ * Rows are sources: GetDistance(from, to) reads distances[from * V + to].
+ * Save writes both matrices to a binary file behind a small header; Open memory-maps such a file,
+ * so a routing matrix built once is available to later runs (and other processes) without copying.
+ */
+class TDistanceMatrix {
+public:
+	// Edge length of the square tiles of the blocked Floyd-Warshall (a 64 x 64 float tile is 16 KB)
+	static constexpr int kTileSize = 64;
+	// Auto uses Floyd-Warshall up to this many vertices, if the graph has at least V / kDenseDivisor edges per vertex
+	static constexpr int kFloydWarshallMaxVertices = 2048;
+	static constexpr int kDenseDivisor = 16;
+	// Larger graphs would need more than 4 GB per matrix
+	static constexpr int kMaxVertices = 32768;
+	// Next hop of an unreachable pair
+	static constexpr int32_t kNoHop = -1;
+
+private:
+	int vertexCount;
+	bool hasNextHops;
+	EAllPairsMethod method; // What Build used (Auto if the matrix was opened from a file)
+
+	// distances / nextHops point into the storage arrays after Build, or into matrixFile after Open
+	TArrayWrapper<float> distanceStorage;
+	TArrayWrapper<int32_t> nextHopStorage;
+	const float* distances;
+	const int32_t* nextHops;
+	TMappedFile matrixFile;
+	uint64_t adjacencyHash;
+
+	/**
+	 * @brief Fills every row with a Dijkstra from its source, one source per pool item.
+	 */
+	void BuildWithDijkstra(TGraph& aGraph, TThreadPool& aPool);
+
+	/**
+	 * @brief Blocked Floyd-Warshall: per round k, the diagonal tile, then its row and column, then the rest in parallel.
+	 */
+	void BuildWithFloydWarshall(const TAdjacencyView& aAdjacency, TThreadPool& aPool);
+
+	/**
+	 * @brief Relaxes tile (aRowTile, aColumnTile) through the vertices of tile aPivotTile.
+	 */
+	void RelaxTile(int aRowTile, int aColumnTile, int aPivotTile);
+
+	void Clear();
+
+public:
+	TDistanceMatrix();
+
+	TDistanceMatrix(const TDistanceMatrix&) = delete;
+	TDistanceMatrix& operator=(const TDistanceMatrix&) = delete;
+
+	/**
+	 * @brief Computes the matrix for aGraph (freezing its adjacency first).
+	 * @param aWithNextHops Also store the first vertex after the source on every shortest path.
+	 * @param aThreadCount Threads of the pool (0 = one per hardware thread).
+	 * @return False if the graph is too large for a dense matrix.
+	 */
+	bool Build(TGraph& aGraph, bool aWithNextHops = false, int aThreadCount = 0, EAllPairsMethod aMethod = EAllPairsMethod::Auto);
+
+	bool Save(const std::string& aFilename) const;
+
+	/**
+	 * @brief Bytes Save writes: a header and 4 bytes per pair, 8 with next hops.
+	 */
+	uint64_t GetFileSize() const;
+
+	/**
+	 * @brief Memory-maps a matrix written by Save. Fails if it was built for a different graph.
+	 */
+	bool Open(const std::string& aFilename, TGraph& aGraph);
+
+	bool IsEmpty() const { return vertexCount == 0; }
+	int GetVertexCount() const { return vertexCount; }
+	bool HasNextHops() const { return hasNextHops; }
+	EAllPairsMethod GetMethod() const { return method; }
+
+	/**
+	 * @brief Shortest path cost; infinity if aTo cannot be reached from aFrom.
+	 */
+	float GetDistance(int aFrom, int aTo) const {
+		return distances[static_cast<std::size_t>(aFrom) * vertexCount + aTo];
+	}
+
+	/**
+	 * @brief First vertex after aFrom on a shortest path to aTo (aFrom itself if aTo == aFrom), or kNoHop.
+	 */
+	int GetNextHop(int aFrom, int aTo) const {
+		return hasNextHops ? nextHops[static_cast<std::size_t>(aFrom) * vertexCount + aTo] : kNoHop;
+	}
+
+	/**
+	 * @brief Follows the next hops from aFrom to aTo. Needs the next-hop matrix.
+	 * @return False if there is no next-hop matrix or no path, or the hops do not lead to aTo (a damaged file).
+	 */
+	bool GetPath(int aFrom, int aTo, std::vector<int>& aOutVertices) const;
+
+	/**
+	 * @brief Prints the matrix as a table (small graphs) or one line per source.
+	 */
+	void Print(const TGraph& aGraph) const;
+};
+
+#endif // DISTANCE_MATRIX_H
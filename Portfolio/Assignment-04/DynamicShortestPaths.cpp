@@ -0,0 +1,188 @@
+#include "DynamicShortestPaths.h"
+#include <algorithm>
+#include <iostream>
+#include <limits>
+
+TDynamicShortestPaths::TDynamicShortestPaths()
+	: source(-1), vertexCount(0), graphVersion(0), heap(0), lastTouchedCount(0)
+{
+}
+
+void TDynamicShortestPaths::Resize(int aVertexCount)
+{
+	if (aVertexCount <= vertexCount)
+	{
+		return;
+	}
+	distances.Resize(aVertexCount, std::numeric_limits<float>::infinity());
+	parents.Resize(aVertexCount, -1);
+	affected.Resize(aVertexCount, 0);
+	heap = TIndexedPriorityQueue<kHeapArity>(aVertexCount);
+	vertexCount = aVertexCount;
+}
+
+void TDynamicShortestPaths::Improve(int aId, float aDistance, int aParent)
+{
+	distances[aId] = aDistance;
+	parents[aId] = aParent;
+	if (heap.Contains(aId))
+	{
+		heap.DecreaseKey(aId, aDistance);
+	}
+	else
+	{
+		heap.Enqueue(aId, aDistance);
+	}
+}
+
+float TDynamicShortestPaths::EdgeWeight(const TAdjacencyView& aAdjacency, int aFrom, int aTo)
+{
+	float weight = std::numeric_limits<float>::infinity();
+	for (uint32_t e = aAdjacency.offsets[aFrom]; e < aAdjacency.offsets[aFrom + 1]; e++)
+	{
+		if (aAdjacency.targets[e] == static_cast<uint32_t>(aTo) && aAdjacency.weights[e] < weight)
+		{
+			weight = aAdjacency.weights[e];
+		}
+	}
+	return weight;
+}
+
+void TDynamicShortestPaths::Propagate(const TAdjacencyView& aAdjacency)
+{
+	while (!heap.IsEmpty())
+	{
+		int u = heap.Dequeue();
+		lastTouchedCount++;
+		float distanceOfU = distances[u];
+		for (uint32_t e = aAdjacency.offsets[u]; e < aAdjacency.offsets[u + 1]; e++)
+		{
+			int v = static_cast<int>(aAdjacency.targets[e]);
+			float distanceThroughU = distanceOfU + aAdjacency.weights[e];
+			if (distanceThroughU < distances[v])
+			{
+				Improve(v, distanceThroughU, u);
+			}
+		}
+	}
+}
+
+bool TDynamicShortestPaths::Build(TGraph& aGraph, const std::string& aSource)
+{
+	int sourceId = aGraph.GetVertexId(aSource);
+	if (sourceId < 0)
+	{
+		std::cerr << "Error: Start city '" << aSource << "' not found." << std::endl;
+		return false;
+	}
+
+	// A plain Dijkstra, so Repair later does the same float arithmetic as the tree was built with
+	TAdjacencyView adjacency = aGraph.GetAdjacency();
+	Resize(adjacency.vertexCount);
+	for (int i = 0; i < vertexCount; i++)
+	{
+		distances[i] = std::numeric_limits<float>::infinity();
+		parents[i] = -1;
+	}
+	source = sourceId;
+	lastTouchedCount = 0;
+	Improve(source, 0.0f, -1);
+	Propagate(adjacency);
+	graphVersion = aGraph.GetVersion();
+	return true;
+}
+
+void TDynamicShortestPaths::Repair(TGraph& aGraph, const std::vector<TEdgeChange>& aChanges)
+{
+	if (source < 0)
+	{
+		return;
+	}
+	TAdjacencyView adjacency = aGraph.GetAdjacency();
+	Resize(adjacency.vertexCount);
+	affectedIds.Clear();
+
+	// 1. Roots: vertices whose tree edge got longer or disappeared (judged on the old distances)
+	for (const TEdgeChange& change : aChanges)
+	{
+		int u = change.fromId;
+		int v = change.toId;
+		if (parents[v] == u && affected[v] == 0 && distances[u] + EdgeWeight(adjacency, u, v) > distances[v])
+		{
+			affected[v] = 1;
+			affectedIds.Add(v);
+		}
+	}
+
+	// 2. Everything below a root in the tree hangs on it (affectedIds doubles as the work list)
+	for (int i = 0; i < affectedIds.GetCount(); i++)
+	{
+		int u = affectedIds[i];
+		for (uint32_t e = adjacency.offsets[u]; e < adjacency.offsets[u + 1]; e++)
+		{
+			int v = static_cast<int>(adjacency.targets[e]);
+			if (parents[v] == u && affected[v] == 0)
+			{
+				affected[v] = 1;
+				affectedIds.Add(v);
+			}
+		}
+	}
+
+	// 3. Reset the affected vertices, then seed each with its cheapest edge from outside (affected sources are infinite now)
+	for (int v : affectedIds)
+	{
+		distances[v] = std::numeric_limits<float>::infinity();
+		parents[v] = -1;
+	}
+	for (int v : affectedIds)
+	{
+		affected[v] = 0;
+		float best = std::numeric_limits<float>::infinity();
+		int bestParent = -1;
+		for (uint32_t e = adjacency.reverseOffsets[v]; e < adjacency.reverseOffsets[v + 1]; e++)
+		{
+			int u = static_cast<int>(adjacency.reverseSources[e]);
+			float candidate = distances[u] + adjacency.reverseWeights[e];
+			if (candidate < best)
+			{
+				best = candidate;
+				bestParent = u;
+			}
+		}
+		if (bestParent >= 0)
+		{
+			Improve(v, best, bestParent);
+		}
+	}
+
+	// 4. Seed the targets of changed edges that now offer a shorter way
+	for (const TEdgeChange& change : aChanges)
+	{
+		float candidate = distances[change.fromId] + EdgeWeight(adjacency, change.fromId, change.toId);
+		if (candidate < distances[change.toId])
+		{
+			Improve(change.toId, candidate, change.fromId);
+		}
+	}
+
+	// 5. One Dijkstra from the seeds settles every distance that changed
+	lastTouchedCount = affectedIds.GetCount();
+	Propagate(adjacency);
+	graphVersion = aGraph.GetVersion();
+}
+
+bool TDynamicShortestPaths::GetPath(int aTargetId, std::vector<int>& aOutVertices) const
+{
+	aOutVertices.clear();
+	if (source < 0 || distances[aTargetId] == std::numeric_limits<float>::infinity())
+	{
+		return false;
+	}
+	for (int v = aTargetId; v != -1; v = parents[v])
+	{
+		aOutVertices.push_back(v);
+	}
+	std::reverse(aOutVertices.begin(), aOutVertices.end());
+	return true;
+}
@@ -0,0 +1,100 @@
+#pragma once
+#ifndef DYNAMIC_SHORTEST_PATHS_H
+#define DYNAMIC_SHORTEST_PATHS_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "ArrayWrapper.hpp"
+#include "IndexedPriorityQueue.hpp"
+#include "Graph.h"
+
+/**
+ * @brief A shortest path tree from one source that is repaired after edge changes instead of recomputed.
+ *
+ * Repair works in the style of Ramalingam-Reps (DynamicSWSF-FP). A changed edge u -> v matters in two ways:
+ * - If it was v's tree edge and got longer (or was removed), v's whole subtree may be wrong. Those
+ *   vertices are the affected ones; they are reset and seeded with their best edge from an unaffected vertex.
+ * - If it now gives v a shorter distance, v is seeded with it.
+ * One Dijkstra from the seeds then fixes every distance that changed. Vertices outside the affected
+ * subtrees and the area that got closer are never touched, so a failed link costs a small local search
+ * instead of a full RunDijkstra.
+ *
+ * Several trees (e.g. one per source) can be repaired from the same TEdgeChange list.
+ */
+class TDynamicShortestPaths {
+public:
+	static constexpr int kHeapArity = 4;
+
+private:
+	int source;
+	int vertexCount;
+	uint64_t graphVersion; // Version of the graph the tree matches
+	TArrayWrapper<float> distances;
+	TArrayWrapper<int> parents; // -1 = source or unreachable
+	TIndexedPriorityQueue<kHeapArity> heap;
+
+	// Repair scratch
+	TArrayWrapper<uint8_t> affected;
+	TArrayWrapper<int> affectedIds;
+	int lastTouchedCount;
+
+	/**
+	 * @brief Grows the arrays to aVertexCount (new vertices start unreachable).
+	 */
+	void Resize(int aVertexCount);
+
+	/**
+	 * @brief Lowers the distance of aId to aDistance via aParent and queues it.
+	 */
+	void Improve(int aId, float aDistance, int aParent);
+
+	/**
+	 * @brief Cheapest edge aFrom -> aTo, infinity if there is none.
+	 */
+	static float EdgeWeight(const TAdjacencyView& aAdjacency, int aFrom, int aTo);
+
+	/**
+	 * @brief Runs Dijkstra from the queued vertices; every vertex it pops is final.
+	 */
+	void Propagate(const TAdjacencyView& aAdjacency);
+
+public:
+	TDynamicShortestPaths();
+
+	/**
+	 * @brief Computes the tree from aSource from scratch.
+	 * @return False if the city does not exist.
+	 */
+	bool Build(TGraph& aGraph, const std::string& aSource);
+
+	/**
+	 * @brief Brings the tree up to date after the edges in aChanges were added, reweighted or removed
+	 * (as reported by TGraph::AddEdge, UpdateEdge, RemoveEdge and RemoveVertex).
+	 */
+	void Repair(TGraph& aGraph, const std::vector<TEdgeChange>& aChanges);
+
+	/**
+	 * @brief True if no edge has changed since the tree was built or last repaired.
+	 */
+	bool IsCurrent(const TGraph& aGraph) const { return graphVersion == aGraph.GetVersion(); }
+
+	int GetSource() const { return source; }
+	int GetVertexCount() const { return vertexCount; }
+
+	/**
+	 * @brief Vertices the last Build or Repair reset or settled (the region it had to touch).
+	 */
+	int GetLastTouchedCount() const { return lastTouchedCount; }
+
+	float GetDistance(int aId) const { return distances[aId]; }
+	int GetParent(int aId) const { return parents[aId]; }
+
+	/**
+	 * @brief Follows the tree from the source to aTargetId.
+	 * @return False (and an empty path) if the target cannot be reached.
+	 */
+	bool GetPath(int aTargetId, std::vector<int>& aOutVertices) const;
+};
+
+#endif // DYNAMIC_SHORTEST_PATHS_H
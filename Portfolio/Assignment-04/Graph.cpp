@@ -1,145 +1,2501 @@
 #include "Graph.h"
-#include "PriorityQueue.hpp"
+#include "ContractionHierarchy.h"
+#include "RoutingCache.h"
+#include "ThreadPool.h"
+#include "ChunkedFileParser.h"
+#include "FileReaderUtils.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cerrno>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <functional>
 #include <iostream>
 #include <limits> // for infinity
+#include <thread>
 
-TGraph::TGraph() : vertexCount(0)
+// Largest weight the bucket queue handles (it needs maxWeight + 1 buckets); above that we use the radix heap
+static constexpr float kMaxBucketQueueWeight = 65536.0f;
+
+// Integer weights must stay exact in a float, so anything at or above 2^24 is treated as non-integer
+static constexpr float kMaxExactIntegerWeight = 16777216.0f;
+
+// Delta-stepping keeps at most this many buckets (a larger delta is used if the requested one would need more)
+static constexpr int kMaxDeltaBuckets = 1 << 20;
+
+// Delta-stepping rounds with fewer vertices than this are relaxed on the calling thread (waking the pool costs more)
+static constexpr int kMinParallelFrontier = 256;
+static constexpr int kDeltaSteppingChunkSize = 64;
+
+// --- In-place CSR edits (frozen graphs). Each moves the tail of the arrays once and shifts the offsets after the range. ---
+
+/**
+ * @brief Inserts (aNeighbour, aWeight) at aSlot, inside aVertex's range.
+ */
+static void InsertIntoRange(TArrayWrapper<uint32_t>& aOffsets, TArrayWrapper<uint32_t>& aNeighbours, TArrayWrapper<float>& aWeights,
+	int aVertex, uint32_t aSlot, uint32_t aNeighbour, float aWeight)
+{
+	aNeighbours.Add(0);
+	aWeights.Add(0.0f);
+	std::size_t tail = static_cast<std::size_t>(aNeighbours.GetCount()) - 1 - aSlot;
+	std::memmove(aNeighbours.GetData() + aSlot + 1, aNeighbours.GetData() + aSlot, sizeof(uint32_t) * tail);
+	std::memmove(aWeights.GetData() + aSlot + 1, aWeights.GetData() + aSlot, sizeof(float) * tail);
+	aNeighbours.GetData()[aSlot] = aNeighbour;
+	aWeights.GetData()[aSlot] = aWeight;
+
+	uint32_t* offsets = aOffsets.GetData();
+	for (int i = aVertex + 1; i < aOffsets.GetCount(); i++)
+	{
+		offsets[i]++;
+	}
+}
+
+/**
+ * @brief Removes the entries for aNeighbour from aVertex's range.
+ * @return How many there were.
+ */
+static int EraseFromRange(TArrayWrapper<uint32_t>& aOffsets, TArrayWrapper<uint32_t>& aNeighbours, TArrayWrapper<float>& aWeights,
+	int aVertex, uint32_t aNeighbour)
+{
+	uint32_t* offsets = aOffsets.GetData();
+	uint32_t* neighbours = aNeighbours.GetData();
+	float* weights = aWeights.GetData();
+
+	// Close the gaps inside the range, then move the tail down over what is left
+	uint32_t rangeEnd = offsets[aVertex + 1];
+	uint32_t write = offsets[aVertex];
+	for (uint32_t e = offsets[aVertex]; e < rangeEnd; e++)
+	{
+		if (neighbours[e] != aNeighbour)
+		{
+			neighbours[write] = neighbours[e];
+			weights[write] = weights[e];
+			write++;
+		}
+	}
+	uint32_t removed = rangeEnd - write;
+	if (removed == 0)
+	{
+		return 0;
+	}
+	std::size_t tail = static_cast<std::size_t>(aNeighbours.GetCount()) - rangeEnd;
+	std::memmove(neighbours + write, neighbours + rangeEnd, sizeof(uint32_t) * tail);
+	std::memmove(weights + write, weights + rangeEnd, sizeof(float) * tail);
+	for (int i = aVertex + 1; i < aOffsets.GetCount(); i++)
+	{
+		offsets[i] -= removed;
+	}
+	aNeighbours.Resize(aNeighbours.GetCount() - static_cast<int>(removed));
+	aWeights.Resize(aWeights.GetCount() - static_cast<int>(removed));
+	return static_cast<int>(removed);
+}
+
+// --- Parallel search labels ---
+// A label packs the distance (high 32 bits, as float bits) and the parent id (low 32 bits),
+// so one compare-and-swap updates both and the parent always matches the distance.
+static constexpr uint32_t kNoParent = 0xFFFFFFFFu;
+
+static uint64_t PackLabel(float aDistance, uint32_t aParent)
+{
+	uint32_t bits = 0;
+	std::memcpy(&bits, &aDistance, sizeof(bits));
+	return (static_cast<uint64_t>(bits) << 32) | aParent;
+}
+
+static float LabelDistance(uint64_t aLabel)
+{
+	uint32_t bits = static_cast<uint32_t>(aLabel >> 32);
+	float distance = 0.0f;
+	std::memcpy(&distance, &bits, sizeof(distance));
+	return distance;
+}
+
+static uint32_t LabelParent(uint64_t aLabel)
+{
+	return static_cast<uint32_t>(aLabel & 0xFFFFFFFFu);
+}
+
+// --- Name index file layout: header, perfect hash blob, uint32 slotToId[vertexCount] ---
+static const char kNameIndexMagic[4] = { 'V', 'I', 'D', 'X' };
+static constexpr uint32_t kNameIndexVersion = 1;
+
+struct TNameIndexHeader
+{
+	char magic[4];
+	uint32_t version;
+	uint32_t vertexCount;
+	uint32_t reserved;
+	uint64_t nameSetHash;
+};
+
+// --- TQueryContext ---
+
+TQueryContext::TQueryContext()
+	: generation(1), vertexCount(0), source(-1), reachedCount(0), heap(0), bucketQueue(0),
+	remainingTargets(0), hasTargets(false)
+{
+}
+
+void TQueryContext::Begin(int aVertexCount, int aSource)
+{
+	if (aVertexCount > stamps.GetCount())
+	{
+		// New entries get stamp 0, which is never a current generation
+		stamps.Resize(aVertexCount, 0);
+		distances.Resize(aVertexCount, 0.0f);
+		integerDistances.Resize(aVertexCount, 0);
+		parents.Resize(aVertexCount, -1);
+		settled.Resize(aVertexCount, 0);
+		targetStamps.Resize(aVertexCount, 0);
+	}
+	if (aVertexCount > heap.GetMaxId())
+	{
+		heap = TIndexedPriorityQueue<kHeapArity>(aVertexCount);
+	}
+
+	generation++;
+	if (generation == 0)
+	{
+		// Wrapped around: old stamps could look current again, so clear them once
+		for (int i = 0; i < stamps.GetCount(); i++)
+		{
+			stamps[i] = 0;
+			targetStamps[i] = 0;
+		}
+		generation = 1;
+	}
+
+	// Queues are only non-empty if the last query stopped early
+	heap.Clear();
+	radixHeap.Clear();
+	bucketQueue.Clear();
+
+	vertexCount = aVertexCount;
+	source = aSource;
+	reachedCount = 0;
+	remainingTargets = 0;
+	hasTargets = false;
+}
+
+uint32_t TQueryContext::GetIntegerDistance(int aId) const
+{
+	return IsReached(aId) ? integerDistances[aId] : std::numeric_limits<uint32_t>::max();
+}
+
+int TQueryContext::GetParent(int aId) const
+{
+	return IsReached(aId) ? parents[aId] : -1;
+}
+
+void TQueryContext::SetLabel(int aId, float aDistance, int aParent)
+{
+	if (stamps[aId] != generation)
+	{
+		stamps[aId] = generation;
+		settled[aId] = 0;
+		reachedCount++;
+	}
+	distances[aId] = aDistance;
+	parents[aId] = aParent;
+}
+
+void TQueryContext::SetIntegerLabel(int aId, uint32_t aDistance, int aParent)
+{
+	SetLabel(aId, static_cast<float>(aDistance), aParent);
+	integerDistances[aId] = aDistance;
+}
+
+void TQueryContext::Settle(int aId)
+{
+	settled[aId] = 1;
+	if (targetStamps[aId] == generation)
+	{
+		remainingTargets--;
+	}
+}
+
+void TQueryContext::AddTarget(int aId)
+{
+	hasTargets = true;
+	if (targetStamps[aId] != generation && !IsSettled(aId))
+	{
+		targetStamps[aId] = generation;
+		remainingTargets++;
+	}
+}
+
+TQueryContext& TQueryContext::GetBackward()
+{
+	if (!backward)
+	{
+		backward.reset(new TQueryContext());
+	}
+	return *backward;
+}
+
+TBucketQueue<int>& TQueryContext::GetBucketQueue(uint32_t aMaxSpan)
+{
+	if (bucketQueue.GetMaxSpan() != aMaxSpan)
+	{
+		bucketQueue = TBucketQueue<int>(aMaxSpan);
+	}
+	return bucketQueue;
+}
+
+// --- TGraph ---
+
+TGraph::TGraph()
+	: vertexCount(0), hasIntegerWeights(true), maxEdgeWeight(0.0f), queueStrategy(EDijkstraQueue::Auto),
+	isFrozen(false), slotToId(nullptr),
+	csrOffsets(0, false, true), csrTargets(0, false, true), csrWeights(0, false, true),
+	reverseOffsets(0, false, true), reverseSources(0, false, true), reverseWeights(0, false, true),
+	isCsrCurrent(false), edgeCount(0), hasEdgeLists(true), routeAlgorithm(ERouteAlgorithm::Dijkstra), landmarkCount(0),
+	hierarchy(nullptr), version(0), routingCache(nullptr), vertexOrder(EVertexOrder::Input), orderedBy(EVertexOrder::Input), orderedVersion(0)
+{
+	// The list will hold the vertices, but we will handle deletion manually
+	// to ensure edges are deleted first.
+}
+
+TGraph::~TGraph()
+{
+	// 1. Delete the Edges of all vertices first
+	ReleaseEdgeLists();
+
+	TLinkedListNode<TVertex*>* currentNode = allVertices.GetHead()->GetNext();
+
+	while (currentNode != allVertices.GetTail())
+	{
+		TVertex* v = currentNode->GetData();
+
+		// Now it is safe to delete the vertex itself
+		delete v;
+
+		currentNode = currentNode->GetNext();
+	}
+
+	// 2. The TLinkedList destructor will run, but we've already cleaned up the data.
+	// (Assuming the list was initialized with isDataOwner = false, which is default)
+}
+
+void TGraph::ReserveVertices(int aCount)
+{
+	vertexLookup.Reserve(aCount);
+	vertexById.Reserve(aCount);
+	inputIndexById.Reserve(aCount);
+}
+
+TVertex* TGraph::FindVertex(std::string_view aName) const
+{
+	if (isFrozen)
+	{
+		// One perfect-hash probe; unknown names land on some vertex, so confirm the name
+		int slot = nameIndex.Lookup(aName);
+		if (slot < 0) return nullptr;
+		TVertex* candidate = vertexById[static_cast<int>(slotToId[slot])];
+		return (candidate->name == aName) ? candidate : nullptr;
+	}
+	TVertex* const* found = vertexLookup.Find(aName);
+	return (found != nullptr) ? *found : nullptr;
+}
+
+uint64_t TGraph::ComputeNameSetHash() const
+{
+	uint64_t hash = static_cast<uint64_t>(vertexCount);
+	for (int i = 0; i < vertexCount; i++)
+	{
+		hash = (hash ^ HashString(vertexById[i]->name, static_cast<uint64_t>(i))) * 0x9E3779B97F4A7C15ULL;
+	}
+	return hash;
+}
+
+void TGraph::Freeze()
+{
+	if (isFrozen) return;
+	ApplyVertexOrder();
+	if (!BuildNameIndex())
+	{
+		// Only possible with duplicate names, which CreateVertex never produces
+		std::cerr << "Error: Could not build the name index." << std::endl;
+		return;
+	}
+	isFrozen = true;
+
+	// The hash map and the edge lists are no longer needed while frozen
+	vertexLookup = THashMap<TVertex*>();
+	EnsureAdjacency();
+	ReleaseEdgeLists();
+}
+
+bool TGraph::BuildNameIndex()
+{
+	TArrayWrapper<std::string_view> names(vertexCount);
+	for (int i = 0; i < vertexCount; i++)
+	{
+		names.Add(vertexById[i]->name);
+	}
+	if (!nameIndex.Build(names.GetData(), vertexCount))
+	{
+		return false;
+	}
+
+	slotToIdStorage.Clear();
+	slotToIdStorage.Resize(vertexCount, 0);
+	for (int i = 0; i < vertexCount; i++)
+	{
+		slotToIdStorage[nameIndex.Lookup(names[i])] = static_cast<uint32_t>(i);
+	}
+	slotToId = slotToIdStorage.GetData();
+	return true;
+}
+
+void TGraph::Thaw()
+{
+	if (!isFrozen) return;
+
+	vertexLookup = THashMap<TVertex*>(vertexCount);
+	for (int i = 0; i < vertexCount; i++)
+	{
+		vertexLookup.Insert(vertexById[i]->name, vertexById[i]);
+	}
+	nameIndex.Clear();
+	slotToIdStorage.Clear();
+	slotToIdStorage.ShrinkToFit();
+	slotToId = nullptr;
+	nameIndexFile.Close();
+	RestoreEdgeLists();
+	isFrozen = false;
+}
+
+void TGraph::EnsureAdjacency()
+{
+	if (isCsrCurrent) return;
+
+	// 1. Offsets: prefix sum of the out-degrees
+	csrOffsets.Clear();
+	csrOffsets.Resize(vertexCount + 1, 0);
+	for (int i = 0; i < vertexCount; i++)
+	{
+		uint32_t degree = 0;
+		for (TEdge* e = vertexById[i]->edges; e != nullptr; e = e->next)
+		{
+			degree++;
+		}
+		csrOffsets[i + 1] = csrOffsets[i] + degree;
+	}
+
+	// 2. Targets and weights, in edge list order
+	csrTargets.Clear();
+	csrWeights.Clear();
+	csrTargets.Reserve(edgeCount);
+	csrWeights.Reserve(edgeCount);
+	for (int i = 0; i < vertexCount; i++)
+	{
+		for (TEdge* e = vertexById[i]->edges; e != nullptr; e = e->next)
+		{
+			csrTargets.Add(static_cast<uint32_t>(e->destination->id));
+			csrWeights.Add(e->weight);
+		}
+	}
+
+	BuildReverseAdjacency();
+	isCsrCurrent = true;
+}
+
+void TGraph::BuildReverseAdjacency()
+{
+	// Count in-degrees, prefix sum, then scatter every edge to its target's range
+	reverseOffsets.Clear();
+	reverseOffsets.Resize(vertexCount + 1, 0);
+	for (int e = 0; e < csrTargets.GetCount(); e++)
+	{
+		reverseOffsets[static_cast<int>(csrTargets[e]) + 1]++;
+	}
+	for (int i = 0; i < vertexCount; i++)
+	{
+		reverseOffsets[i + 1] += reverseOffsets[i];
+	}
+	reverseSources.Clear();
+	reverseWeights.Clear();
+	reverseSources.Resize(edgeCount, 0);
+	reverseWeights.Resize(edgeCount, 0.0f);
+	TArrayWrapper<uint32_t> fill(vertexCount);
+	for (int i = 0; i < vertexCount; i++)
+	{
+		fill.Add(reverseOffsets[i]);
+	}
+	for (int i = 0; i < vertexCount; i++)
+	{
+		for (uint32_t e = csrOffsets[i]; e < csrOffsets[i + 1]; e++)
+		{
+			uint32_t slot = fill[static_cast<int>(csrTargets[e])]++;
+			reverseSources[slot] = static_cast<uint32_t>(i);
+			reverseWeights[slot] = csrWeights[e];
+		}
+	}
+}
+
+void TGraph::ReleaseEdgeLists()
+{
+	for (int i = 0; i < vertexById.GetCount(); i++)
+	{
+		// Delete the linked list of edges for this vertex
+		TEdge* currentEdge = vertexById[i]->edges;
+		while (currentEdge != nullptr)
+		{
+			TEdge* temp = currentEdge;
+			currentEdge = currentEdge->next;
+			delete temp;
+		}
+		vertexById[i]->edges = nullptr;
+	}
+	hasEdgeLists = false;
+}
+
+void TGraph::RestoreEdgeLists()
+{
+	// Prepending from the back leaves each list in CSR order
+	for (int i = 0; i < vertexCount; i++)
+	{
+		for (uint32_t e = csrOffsets[i + 1]; e > csrOffsets[i]; e--)
+		{
+			vertexById[i]->AddEdge(vertexById[static_cast<int>(csrTargets[e - 1])], csrWeights[e - 1]);
+		}
+	}
+	hasEdgeLists = true;
+}
+
+void TGraph::EnsureEdgeLists()
+{
+	if (!hasEdgeLists)
+	{
+		RestoreEdgeLists();
+	}
+}
+
+// --- Vertex orders (see EVertexOrder) ---
+
+/**
+ * @brief In + out degree of every vertex.
+ */
+static void ComputeDegrees(const TAdjacencyView& aView, TArrayWrapper<uint32_t>& aOutDegrees)
+{
+	aOutDegrees.Clear();
+	aOutDegrees.Resize(aView.vertexCount, 0);
+	for (int v = 0; v < aView.vertexCount; v++)
+	{
+		aOutDegrees[v] = (aView.offsets[v + 1] - aView.offsets[v]) + (aView.reverseOffsets[v + 1] - aView.reverseOffsets[v]);
+	}
+}
+
+/**
+ * @brief All vertex ids sorted by degree (counting sort, so equal degrees keep id order).
+ */
+static void SortByDegree(const TArrayWrapper<uint32_t>& aDegrees, bool aIsDescending, TArrayWrapper<int>& aOutOrder)
+{
+	int vertexCount = aDegrees.GetCount();
+	uint32_t maxDegree = 0;
+	for (int v = 0; v < vertexCount; v++)
+	{
+		if (aDegrees[v] > maxDegree) maxDegree = aDegrees[v];
+	}
+	TArrayWrapper<int> starts;
+	starts.Resize(static_cast<int>(maxDegree) + 2, 0);
+	for (int v = 0; v < vertexCount; v++)
+	{
+		int key = aIsDescending ? static_cast<int>(maxDegree - aDegrees[v]) : static_cast<int>(aDegrees[v]);
+		starts[key + 1]++;
+	}
+	for (int k = 0; k <= static_cast<int>(maxDegree); k++)
+	{
+		starts[k + 1] += starts[k];
+	}
+	aOutOrder.Clear();
+	aOutOrder.Resize(vertexCount, 0);
+	for (int v = 0; v < vertexCount; v++)
+	{
+		int key = aIsDescending ? static_cast<int>(maxDegree - aDegrees[v]) : static_cast<int>(aDegrees[v]);
+		aOutOrder[starts[key]++] = v;
+	}
+}
+
+/**
+ * @brief Breadth-first order over the edges in both directions; every component starts at its first vertex in aStarts.
+ * With aIsByDegree the new neighbours of a vertex are queued by increasing degree (Cuthill-McKee).
+ */
+static void BreadthFirstOrder(const TAdjacencyView& aView, const TArrayWrapper<int>& aStarts, const TArrayWrapper<uint32_t>& aDegrees,
+	bool aIsByDegree, TArrayWrapper<int>& aOutOrder)
+{
+	TArrayWrapper<uint8_t> isQueued;
+	isQueued.Resize(aView.vertexCount, 0);
+	aOutOrder.Clear();
+	aOutOrder.Reserve(aView.vertexCount);
+	for (int s = 0; s < aStarts.GetCount(); s++)
+	{
+		if (isQueued[aStarts[s]] != 0) continue;
+		isQueued[aStarts[s]] = 1;
+		aOutOrder.Add(aStarts[s]);
+
+		// The order doubles as the queue: the vertices after head are queued but not expanded yet
+		for (int head = aOutOrder.GetCount() - 1; head < aOutOrder.GetCount(); head++)
+		{
+			int v = aOutOrder[head];
+			int firstNew = aOutOrder.GetCount();
+			for (uint32_t e = aView.offsets[v]; e < aView.offsets[v + 1]; e++)
+			{
+				int target = static_cast<int>(aView.targets[e]);
+				if (isQueued[target] != 0) continue;
+				isQueued[target] = 1;
+				aOutOrder.Add(target);
+			}
+			for (uint32_t e = aView.reverseOffsets[v]; e < aView.reverseOffsets[v + 1]; e++)
+			{
+				int source = static_cast<int>(aView.reverseSources[e]);
+				if (isQueued[source] != 0) continue;
+				isQueued[source] = 1;
+				aOutOrder.Add(source);
+			}
+			if (!aIsByDegree) continue;
+
+			// Insertion sort of the (few) new neighbours, stable for equal degrees
+			int* queued = aOutOrder.GetData();
+			for (int i = firstNew + 1; i < aOutOrder.GetCount(); i++)
+			{
+				int item = queued[i];
+				int j = i - 1;
+				while (j >= firstNew && aDegrees[queued[j]] > aDegrees[item])
+				{
+					queued[j + 1] = queued[j];
+					j--;
+				}
+				queued[j + 1] = item;
+			}
+		}
+	}
+}
+
+void TGraph::RenumberVertices(const TArrayWrapper<int>& aOrder)
+{
+	// 1. Permute the CSR, keeping each vertex's edges in their order (works with or without edge lists)
+	EnsureAdjacency();
+	TArrayWrapper<int> newIds;
+	newIds.Resize(vertexCount, 0);
+	for (int i = 0; i < vertexCount; i++)
+	{
+		newIds[aOrder[i]] = i;
+	}
+	TArrayWrapper<uint32_t> offsets(0, false, true);
+	TArrayWrapper<uint32_t> targets(0, false, true);
+	TArrayWrapper<float> weights(0, false, true);
+	offsets.Reserve(vertexCount + 1);
+	targets.Reserve(edgeCount);
+	weights.Reserve(edgeCount);
+	offsets.Add(0);
+	for (int i = 0; i < vertexCount; i++)
+	{
+		int oldId = aOrder[i];
+		for (uint32_t e = csrOffsets[oldId]; e < csrOffsets[oldId + 1]; e++)
+		{
+			targets.Add(static_cast<uint32_t>(newIds[static_cast<int>(csrTargets[e])]));
+			weights.Add(csrWeights[e]);
+		}
+		offsets.Add(static_cast<uint32_t>(targets.GetCount()));
+	}
+	csrOffsets = std::move(offsets);
+	csrTargets = std::move(targets);
+	csrWeights = std::move(weights);
+	BuildReverseAdjacency();
+
+	// 2. Renumber the vertices themselves
+	TArrayWrapper<TVertex*> renumbered(vertexCount);
+	TArrayWrapper<int> inputIndices(vertexCount);
+	for (int i = 0; i < vertexCount; i++)
+	{
+		TVertex* vertex = vertexById[aOrder[i]];
+		vertex->id = i;
+		renumbered.Add(vertex);
+		inputIndices.Add(inputIndexById[aOrder[i]]);
+	}
+	vertexById = std::move(renumbered);
+	inputIndexById = std::move(inputIndices);
+
+	// Landmark distances and the hierarchy are indexed by the old ids
+	landmarkCount = 0;
+	hierarchy = nullptr;
+	version++;
+}
+
+void TGraph::ApplyVertexOrder()
+{
+	if (orderedBy == vertexOrder && orderedVersion == version)
+	{
+		return;
+	}
+
+	// 1. Start from creation order, so an order comes out the same however the ids were numbered before
+	bool isInputOrder = true;
+	for (int i = 0; i < vertexCount && isInputOrder; i++)
+	{
+		isInputOrder = inputIndexById[i] == i;
+	}
+	if (!isInputOrder)
+	{
+		TArrayWrapper<int> order;
+		order.Resize(vertexCount, 0);
+		for (int i = 0; i < vertexCount; i++)
+		{
+			order[inputIndexById[i]] = i;
+		}
+		RenumberVertices(order);
+	}
+	orderedBy = vertexOrder;
+	orderedVersion = version;
+	if (vertexOrder == EVertexOrder::Input || vertexCount == 0)
+	{
+		return;
+	}
+
+	// 2. Number by the chosen order, computed on the CSR of the creation order
+	TAdjacencyView view = GetAdjacency();
+	TArrayWrapper<uint32_t> degrees;
+	ComputeDegrees(view, degrees);
+	TArrayWrapper<int> order;
+	if (vertexOrder == EVertexOrder::Degree)
+	{
+		SortByDegree(degrees, true, order);
+	}
+	else if (vertexOrder == EVertexOrder::Bfs)
+	{
+		TArrayWrapper<int> starts;
+		starts.Resize(vertexCount, 0);
+		for (int i = 0; i < vertexCount; i++)
+		{
+			starts[i] = i;
+		}
+		BreadthFirstOrder(view, starts, degrees, false, order);
+	}
+	else
+	{
+		// Each component starts at its lowest-degree vertex, which tends to lie on its rim
+		TArrayWrapper<int> starts;
+		SortByDegree(degrees, false, starts);
+		BreadthFirstOrder(view, starts, degrees, true, order);
+		for (int i = 0, j = vertexCount - 1; i < j; i++, j--)
+		{
+			std::swap(order[i], order[j]);
+		}
+	}
+	RenumberVertices(order);
+	orderedVersion = version;
+}
+
+void TGraph::SetVertexOrder(EVertexOrder aOrder)
+{
+	if (aOrder == vertexOrder) return;
+	vertexOrder = aOrder;
+	Thaw();
+}
+
+bool TGraph::SaveNameIndex(const std::string& aFilename) const
+{
+	if (!isFrozen)
+	{
+		std::cerr << "Error: Freeze the graph before saving its name index." << std::endl;
+		return false;
+	}
+	std::ofstream file(aFilename, std::ios::binary | std::ios::trunc);
+	if (!file.is_open())
+	{
+		return false;
+	}
+
+	TNameIndexHeader header;
+	std::memcpy(header.magic, kNameIndexMagic, sizeof(kNameIndexMagic));
+	header.version = kNameIndexVersion;
+	header.vertexCount = static_cast<uint32_t>(vertexCount);
+	header.reserved = 0;
+	header.nameSetHash = ComputeNameSetHash();
+	file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+	nameIndex.Serialize(file);
+	file.write(reinterpret_cast<const char*>(slotToId), static_cast<std::streamsize>(sizeof(uint32_t) * vertexCount));
+	return file.good();
+}
+
+bool TGraph::LoadNameIndex(const std::string& aFilename)
+{
+	Thaw();
+	ApplyVertexOrder();
+	if (!nameIndexFile.Open(aFilename))
+	{
+		return false;
+	}
+
+	TNameIndexHeader header;
+	const unsigned char* data = nameIndexFile.GetData();
+	std::size_t size = nameIndexFile.GetSize();
+	bool valid = size >= sizeof(header);
+	if (valid)
+	{
+		std::memcpy(&header, data, sizeof(header));
+		valid = std::memcmp(header.magic, kNameIndexMagic, sizeof(kNameIndexMagic)) == 0
+			&& header.version == kNameIndexVersion
+			&& header.vertexCount == static_cast<uint32_t>(vertexCount)
+			&& header.nameSetHash == ComputeNameSetHash();
+	}
+	valid = valid && nameIndex.Attach(data + sizeof(header), size - sizeof(header))
+		&& nameIndex.GetKeyCount() == vertexCount;
+	std::size_t idsOffset = sizeof(header) + nameIndex.GetSerializedSize();
+	valid = valid && size >= idsOffset + sizeof(uint32_t) * vertexCount;
+
+	// FindVertex indexes vertexById with these, so they must be distinct vertex ids
+	if (valid)
+	{
+		const uint32_t* ids = reinterpret_cast<const uint32_t*>(data + idsOffset);
+		std::vector<uint8_t> isIdTaken(static_cast<std::size_t>(vertexCount), 0);
+		for (int slot = 0; slot < vertexCount && valid; slot++)
+		{
+			valid = ids[slot] < static_cast<uint32_t>(vertexCount) && isIdTaken[ids[slot]] == 0;
+			if (valid) isIdTaken[ids[slot]] = 1;
+		}
+	}
+	if (!valid)
+	{
+		nameIndex.Clear();
+		nameIndexFile.Close();
+		return false;
+	}
+
+	slotToId = reinterpret_cast<const uint32_t*>(data + idsOffset);
+	isFrozen = true;
+	vertexLookup = THashMap<TVertex*>();
+	EnsureAdjacency();
+	ReleaseEdgeLists();
+	return true;
+}
+
+// --- Bulk loading ---
+
+// Vertex ids are ints, and DIMACS ids are 1-based
+static constexpr uint64_t kMaxBulkVertexCount = 0x7FFFFFFEu;
+
+// What one chunk of a bulk load parsed: its edges in file order, and what the whole file needs to know about them
+struct TEdgeBuffer
+{
+	std::vector<uint32_t> sources;
+	std::vector<uint32_t> targets;
+	std::vector<float> weights;
+	float maxWeight = 0.0f;
+	bool hasIntegerWeights = true;
+	// Numeric formats
+	uint32_t maxId = 0;                 // Largest (0-based) id of an edge end
+	long long declaredVertexCount = -1; // From a DIMACS "p" line; -1 if the chunk has none
+	int lineCount = 0;
+	int errorLine = -1;                 // First invalid line, counted from the chunk's first line; -1 if none
+	// Text format: edge ends naming a city the [NODES] sections left out, as (2 * edge + end, name), end 0 = from
+	std::vector<std::pair<std::size_t, std::string_view>> unknownEnds;
+};
+
+/**
+ * @brief Appends one parsed edge to aBuffer and updates its weight profile (as TGraph::TrackWeight would).
+ */
+static void AppendEdge(TEdgeBuffer& aBuffer, uint32_t aFrom, uint32_t aTo, float aWeight)
+{
+	aBuffer.sources.push_back(aFrom);
+	aBuffer.targets.push_back(aTo);
+	aBuffer.weights.push_back(aWeight);
+	aBuffer.maxWeight = std::max(aBuffer.maxWeight, aWeight);
+	if (aWeight < 0.0f || aWeight != std::floor(aWeight))
+	{
+		aBuffer.hasIntegerWeights = false;
+	}
+}
+
+/**
+ * @brief Parses one line of a numeric graph file (without its '\n') into aBuffer.
+ * @return False if the line is invalid.
+ */
+static bool ParseNumericLine(const char* aCursor, const char* aEnd, ENumericGraphFormat aFormat, TEdgeBuffer& aBuffer)
+{
+	TChunkedFileParser::SkipSeparators(aCursor, aEnd);
+	if (aCursor == aEnd)
+	{
+		return true;
+	}
+
+	uint64_t from = 0;
+	uint64_t to = 0;
+	float weight = 1.0f;
+	if (aFormat == ENumericGraphFormat::Dimacs)
+	{
+		char kind = *aCursor++;
+		if (kind == 'c')
+		{
+			return true;
+		}
+		if (kind == 'p')
+		{
+			// "p sp N M": the problem name is skipped, the arc count is only checked to be there
+			TChunkedFileParser::SkipSeparators(aCursor, aEnd);
+			while (aCursor < aEnd && *aCursor != ' ' && *aCursor != '\t')
+			{
+				aCursor++;
+			}
+			uint64_t vertexCount = 0;
+			uint64_t arcCount = 0;
+			if (!TChunkedFileParser::ReadUnsigned(aCursor, aEnd, vertexCount) || !TChunkedFileParser::ReadUnsigned(aCursor, aEnd, arcCount)
+				|| vertexCount > kMaxBulkVertexCount)
+			{
+				return false;
+			}
+			aBuffer.declaredVertexCount = static_cast<long long>(vertexCount);
+			return true;
+		}
+		if (kind != 'a' || !TChunkedFileParser::ReadUnsigned(aCursor, aEnd, from) || !TChunkedFileParser::ReadUnsigned(aCursor, aEnd, to)
+			|| !TChunkedFileParser::ReadFloat(aCursor, aEnd, weight) || from == 0 || to == 0)
+		{
+			return false;
+		}
+		from--;
+		to--;
+	}
+	else
+	{
+		if (*aCursor == '#' || *aCursor == '%')
+		{
+			return true;
+		}
+		if (!TChunkedFileParser::ReadUnsigned(aCursor, aEnd, from) || !TChunkedFileParser::ReadUnsigned(aCursor, aEnd, to))
+		{
+			return false;
+		}
+		TChunkedFileParser::SkipSeparators(aCursor, aEnd);
+		if (aCursor < aEnd && !TChunkedFileParser::ReadFloat(aCursor, aEnd, weight))
+		{
+			return false;
+		}
+	}
+	TChunkedFileParser::SkipSeparators(aCursor, aEnd);
+	if (aCursor != aEnd || from >= kMaxBulkVertexCount || to >= kMaxBulkVertexCount || !std::isfinite(weight) || weight < 0.0f)
+	{
+		return false;
+	}
+
+	AppendEdge(aBuffer, static_cast<uint32_t>(from), static_cast<uint32_t>(to), weight);
+	aBuffer.maxId = std::max(aBuffer.maxId, static_cast<uint32_t>(std::max(from, to)));
+	return true;
+}
+
+bool TGraph::LoadNumericGraph(const std::string& aFilename, ENumericGraphFormat aFormat, int aThreadCount)
+{
+	if (vertexCount > 0)
+	{
+		std::cerr << "Error: A numeric graph can only be loaded into an empty graph." << std::endl;
+		return false;
+	}
+	TChunkedFileParser parser;
+	if (!parser.Open(aFilename))
+	{
+		std::cerr << "Error: Could not read " << aFilename << "." << std::endl;
+		return false;
+	}
+
+	// 1. Parse the chunks in parallel, each into its own buffer
+	std::vector<TEdgeBuffer> buffers(static_cast<std::size_t>(parser.GetChunkCount()));
+	TThreadPool pool(aThreadCount);
+	parser.ParseChunks(pool, [&](const char* aBegin, const char* aEnd, int aChunkIndex, int)
+		{
+			TEdgeBuffer& buffer = buffers[static_cast<std::size_t>(aChunkIndex)];
+			if (aChunkIndex == 0 && aEnd - aBegin >= 3 && std::memcmp(aBegin, "\xEF\xBB\xBF", 3) == 0)
+			{
+				aBegin += 3; // UTF-8 byte order mark
+			}
+			for (const char* line = aBegin; line < aEnd; buffer.lineCount++)
+			{
+				const char* lineEnd = TChunkedFileParser::FindLineEnd(line, aEnd);
+				if (!ParseNumericLine(line, lineEnd, aFormat, buffer))
+				{
+					buffer.errorLine = buffer.lineCount;
+					return;
+				}
+				line = lineEnd + 1;
+			}
+		});
+	parser.Close();
+
+	// 2. Combine what the chunks found, in file order
+	long long declaredVertexCount = -1;
+	long long maxId = -1;
+	std::size_t totalEdges = 0;
+	long long lineOffset = 0;
+	for (const TEdgeBuffer& buffer : buffers)
+	{
+		if (buffer.errorLine >= 0)
+		{
+			std::cerr << "Error: Invalid line " << (lineOffset + buffer.errorLine + 1) << " in " << aFilename << "." << std::endl;
+			return false;
+		}
+		lineOffset += buffer.lineCount;
+		if (buffer.declaredVertexCount >= 0)
+		{
+			if (declaredVertexCount >= 0 && declaredVertexCount != buffer.declaredVertexCount)
+			{
+				std::cerr << "Error: Conflicting problem lines in " << aFilename << "." << std::endl;
+				return false;
+			}
+			declaredVertexCount = buffer.declaredVertexCount;
+		}
+		if (!buffer.sources.empty())
+		{
+			maxId = std::max(maxId, static_cast<long long>(buffer.maxId));
+		}
+		totalEdges += buffer.sources.size();
+	}
+	long long fileVertexCount = maxId + 1;
+	if (aFormat == ENumericGraphFormat::Dimacs)
+	{
+		if (declaredVertexCount < 0 || maxId >= declaredVertexCount)
+		{
+			std::cerr << "Error: " << aFilename << " has no problem line, or an arc to a vertex beyond it." << std::endl;
+			return false;
+		}
+		fileVertexCount = declaredVertexCount;
+	}
+	if (totalEdges > static_cast<std::size_t>(std::numeric_limits<int>::max()))
+	{
+		std::cerr << "Error: " << aFilename << " has too many edges." << std::endl;
+		return false;
+	}
+
+	// 3. The vertices, named after their ids in the file
+	int idBase = (aFormat == ENumericGraphFormat::Dimacs) ? 1 : 0;
+	int count = static_cast<int>(fileVertexCount);
+	vertexById.Reserve(count);
+	inputIndexById.Reserve(count);
+	for (int i = 0; i < count; i++)
+	{
+		TVertex* vertex = new TVertex(std::to_string(i + idBase), i);
+		allVertices.Append(vertex);
+		vertexById.Add(vertex);
+		inputIndexById.Add(i);
+	}
+	vertexCount = count;
+	version++;
+
+	// 4. The edges, straight into the CSR
+	for (const TEdgeBuffer& buffer : buffers)
+	{
+		TrackWeight(buffer.maxWeight);
+		if (!buffer.hasIntegerWeights)
+		{
+			hasIntegerWeights = false;
+		}
+	}
+	BuildCsrFromBuffers(buffers, false);
+
+	// 5. Freeze; there are no edge lists to release (Thaw recreates them from the CSR)
+	ApplyVertexOrder();
+	if (!BuildNameIndex())
+	{
+		std::cerr << "Error: Could not build the name index of " << aFilename << "." << std::endl;
+		return false;
+	}
+	isFrozen = true;
+	return true;
+}
+
+// Sections of the [NODES]/[EDGES] text format
+enum class ETextSection
+{
+	None,
+	Nodes,
+	Edges
+};
+
+/**
+ * @brief One line of the text format as readGraphFromFile sees it: without a UTF-8 byte order mark and a trailing '\r'.
+ */
+static std::string_view TrimTextLine(const char* aBegin, const char* aEnd)
+{
+	std::string_view line(aBegin, static_cast<std::size_t>(aEnd - aBegin));
+	if (line.size() >= 3 && line.compare(0, 3, "\xEF\xBB\xBF") == 0)
+	{
+		line.remove_prefix(3);
+	}
+	if (!line.empty() && line.back() == '\r')
+	{
+		line.remove_suffix(1);
+	}
+	return line;
+}
+
+/**
+ * @brief The section a header line ("[...]") starts; any other header ends the current one.
+ */
+static ETextSection TextSectionOf(std::string_view aHeader)
+{
+	if (aHeader.find("[NODES") != std::string_view::npos) return ETextSection::Nodes;
+	if (aHeader.find("[EDGES") != std::string_view::npos) return ETextSection::Edges;
+	return ETextSection::None;
+}
+
+/**
+ * @brief Splits an [EDGES] line "From;To;Weight" as readGraphFromFile does, with std::stof rules for the weight.
+ * @return False if readGraphFromFile would skip the line (a missing field, or a weight that is not a float in range).
+ */
+static bool ParseTextEdge(std::string_view aLine, std::string_view& aOutFrom, std::string_view& aOutTo, float& aOutWeight)
+{
+	std::size_t first = aLine.find(';');
+	std::size_t second = (first == std::string_view::npos) ? first : aLine.find(';', first + 1);
+	if (second == std::string_view::npos || second + 1 == aLine.size())
+	{
+		return false;
+	}
+	aOutFrom = aLine.substr(0, first);
+	aOutTo = aLine.substr(first + 1, second - first - 1);
+
+	// strtof needs a terminated string; weights are short, so this is a stack copy
+	std::string_view weight = aLine.substr(second + 1);
+	char text[64];
+	std::string longText;
+	const char* start = text;
+	if (weight.size() < sizeof(text))
+	{
+		std::memcpy(text, weight.data(), weight.size());
+		text[weight.size()] = '\0';
+	}
+	else
+	{
+		longText.assign(weight);
+		start = longText.c_str();
+	}
+	char* end = nullptr;
+	errno = 0;
+	aOutWeight = std::strtof(start, &end);
+	return end != start && errno != ERANGE;
+}
+
+bool TGraph::LoadTextGraph(const std::string& aFilename, int aThreadCount)
+{
+	if (vertexCount > 0)
+	{
+		std::cerr << "Error: A text graph can only be bulk-loaded into an empty graph." << std::endl;
+		return false;
+	}
+	TChunkedFileParser parser;
+	if (!parser.Open(aFilename))
+	{
+		std::cerr << "Error: Could not read " << aFilename << "." << std::endl;
+		return false;
+	}
+
+	// 1. Nodes pass (one thread, in file order): every [NODES] name gets its id, and every chunk the section it starts in
+	std::vector<ETextSection> chunkSections(static_cast<std::size_t>(parser.GetChunkCount()), ETextSection::None);
+	ETextSection section = ETextSection::None;
+	parser.ParseChunksInOrder([&](const char* aBegin, const char* aEnd, int aChunkIndex, int)
+		{
+			chunkSections[static_cast<std::size_t>(aChunkIndex)] = section;
+			for (const char* cursor = aBegin; cursor < aEnd; )
+			{
+				const char* lineEnd = TChunkedFileParser::FindLineEnd(cursor, aEnd);
+				std::string_view line = TrimTextLine(cursor, lineEnd);
+				cursor = lineEnd + 1;
+				if (line.empty())
+				{
+					continue;
+				}
+				if (line[0] == '[')
+				{
+					section = TextSectionOf(line);
+					if (section == ETextSection::Nodes)
+					{
+						ReserveVertices(vertexCount + GetRecordCount(std::string(line)));
+					}
+				}
+				else if (section == ETextSection::Nodes)
+				{
+					CreateVertex(std::string(line));
+				}
+			}
+		});
+
+	// 2. Edges pass (all threads): (from, to, weight) per chunk, with read-only lookups in the finished hash map
+	std::vector<TEdgeBuffer> buffers(static_cast<std::size_t>(parser.GetChunkCount()));
+	TThreadPool pool(aThreadCount);
+	parser.ParseChunks(pool, [&](const char* aBegin, const char* aEnd, int aChunkIndex, int)
+		{
+			TEdgeBuffer& buffer = buffers[static_cast<std::size_t>(aChunkIndex)];
+			ETextSection chunkSection = chunkSections[static_cast<std::size_t>(aChunkIndex)];
+			// Files usually list a city's edges together, so the previous line's source is looked up only once
+			std::string_view lastFrom;
+			const TVertex* lastFromV = nullptr;
+			for (const char* cursor = aBegin; cursor < aEnd; )
+			{
+				const char* lineEnd = TChunkedFileParser::FindLineEnd(cursor, aEnd);
+				std::string_view line = TrimTextLine(cursor, lineEnd);
+				cursor = lineEnd + 1;
+				if (line.empty())
+				{
+					continue;
+				}
+				std::string_view from;
+				std::string_view to;
+				float weight = 0.0f;
+				if (line[0] == '[')
+				{
+					chunkSection = TextSectionOf(line);
+				}
+				else if (chunkSection == ETextSection::Edges && ParseTextEdge(line, from, to, weight))
+				{
+					if (lastFromV == nullptr || from != lastFrom)
+					{
+						lastFrom = from;
+						lastFromV = FindVertex(from);
+					}
+					const TVertex* fromV = lastFromV;
+					const TVertex* toV = FindVertex(to);
+					std::size_t edge = buffer.sources.size();
+					if (fromV == nullptr) buffer.unknownEnds.push_back({ 2 * edge, from });
+					if (toV == nullptr) buffer.unknownEnds.push_back({ 2 * edge + 1, to });
+					AppendEdge(buffer, (fromV != nullptr) ? static_cast<uint32_t>(fromV->id) : 0u,
+						(toV != nullptr) ? static_cast<uint32_t>(toV->id) : 0u, weight);
+				}
+			}
+		});
+
+	std::size_t totalEdges = 0;
+	for (const TEdgeBuffer& buffer : buffers)
+	{
+		totalEdges += buffer.sources.size();
+	}
+	if (totalEdges > static_cast<std::size_t>(std::numeric_limits<int>::max()))
+	{
+		std::cerr << "Error: " << aFilename << " has too many edges." << std::endl;
+		return false;
+	}
+
+	// 3. Cities named only by edges, in the order AddEdge would have created them
+	for (TEdgeBuffer& buffer : buffers)
+	{
+		for (const std::pair<std::size_t, std::string_view>& end : buffer.unknownEnds)
+		{
+			uint32_t id = static_cast<uint32_t>(CreateVertex(std::string(end.second))->id);
+			((end.first % 2 == 0) ? buffer.sources : buffer.targets)[end.first / 2] = id;
+		}
+		buffer.unknownEnds = std::vector<std::pair<std::size_t, std::string_view>>();
+	}
+	parser.Close();
+
+	// 4. The CSR, in the order the edge lists of AddEdge would give
+	for (const TEdgeBuffer& buffer : buffers)
+	{
+		TrackWeight(buffer.maxWeight);
+		if (!buffer.hasIntegerWeights)
+		{
+			hasIntegerWeights = false;
+		}
+	}
+	BuildCsrFromBuffers(buffers, true);
+	if (edgeCount > 0)
+	{
+		landmarkCount = 0;
+		OnEdgesChanged();
+	}
+	return true;
+}
+
+void TGraph::BuildCsrFromBuffers(std::vector<TEdgeBuffer>& aBuffers, bool aIsReversed)
+{
+	// 1. Offsets: count the out-degrees, then prefix sum
+	csrOffsets.Clear();
+	csrOffsets.Resize(vertexCount + 1, 0);
+	int total = 0;
+	for (const TEdgeBuffer& buffer : aBuffers)
+	{
+		for (uint32_t source : buffer.sources)
+		{
+			csrOffsets[static_cast<int>(source) + 1]++;
+		}
+		total += static_cast<int>(buffer.sources.size());
+	}
+	for (int i = 0; i < vertexCount; i++)
+	{
+		csrOffsets[i + 1] += csrOffsets[i];
+	}
+
+	// 2. Scatter every edge to the next free place in its source's range, freeing each buffer once it is done
+	csrTargets.Clear();
+	csrWeights.Clear();
+	csrTargets.Resize(total, 0);
+	csrWeights.Resize(total, 0.0f);
+	TArrayWrapper<uint32_t> fill(vertexCount);
+	for (int i = 0; i < vertexCount; i++)
+	{
+		fill.Add(csrOffsets[i]);
+	}
+	for (std::size_t b = 0; b < aBuffers.size(); b++)
+	{
+		TEdgeBuffer& buffer = aBuffers[aIsReversed ? aBuffers.size() - 1 - b : b];
+		std::size_t count = buffer.sources.size();
+		for (std::size_t i = 0; i < count; i++)
+		{
+			std::size_t e = aIsReversed ? count - 1 - i : i;
+			uint32_t slot = fill[static_cast<int>(buffer.sources[e])]++;
+			csrTargets[static_cast<int>(slot)] = buffer.targets[e];
+			csrWeights[static_cast<int>(slot)] = buffer.weights[e];
+		}
+		buffer = TEdgeBuffer();
+	}
+	edgeCount = total;
+	BuildReverseAdjacency();
+	isCsrCurrent = true;
+	hasEdgeLists = false;
+}
+
+TVertex* TGraph::CreateVertex(const std::string& aName)
+{
+	// 1. Check if it exists
+	TVertex* existing = FindVertex(aName);
+	if (existing != nullptr)
+	{
+		return existing;
+	}
+
+	// 2. Create new (a frozen name index cannot take new names, and landmark tables and the CSR have no row for it)
+	Thaw();
+	EnsureEdgeLists();
+	isCsrCurrent = false;
+	landmarkCount = 0;
+	hierarchy = nullptr;
+	version++;
+	TVertex* newVertex = new TVertex(aName, vertexCount);
+
+	// 3. Add to storage (List), Lookup (BST) and the id table
+	allVertices.Append(newVertex);
+	vertexLookup.Insert(aName, newVertex);
+	vertexById.Add(newVertex);
+	inputIndexById.Add(vertexCount);
+	vertexCount++;
+
+	return newVertex;
+}
+
+void TGraph::AddEdge(const std::string& aFrom, const std::string& aTo, float aWeight, std::vector<TEdgeChange>* aOutChanges)
+{
+	// Ensure both vertices exist (a new city thaws the graph)
+	TVertex* fromV = CreateVertex(aFrom);
+	TVertex* toV = CreateVertex(aTo);
+
+	if (isFrozen)
+	{
+		// Both cities existed: one insert into the CSR instead of thawing and rebuilding everything
+		InsertCsrEdge(fromV->id, toV->id, aWeight);
+	}
+	else
+	{
+		// Add the directed edge (to the edge lists; the CSR is rebuilt before the next query)
+		EnsureEdgeLists();
+		fromV->AddEdge(toV, aWeight);
+		isCsrCurrent = false;
+	}
+	edgeCount++;
+	landmarkCount = 0; // A new edge can make the stored distances too long to be lower bounds
+	TrackWeight(aWeight);
+	OnEdgesChanged();
+	if (aOutChanges != nullptr)
+	{
+		aOutChanges->push_back({ fromV->id, toV->id });
+	}
+}
+
+void TGraph::TrackWeight(float aWeight)
+{
+	// Track whether the monotone integer queues can still be used
+	if (aWeight < 0.0f || aWeight >= kMaxExactIntegerWeight || aWeight != std::floor(aWeight))
+	{
+		hasIntegerWeights = false;
+	}
+	// Only ever raised, so after an edit it is an upper bound rather than the exact maximum
+	if (aWeight > maxEdgeWeight)
+	{
+		maxEdgeWeight = aWeight;
+	}
+}
+
+void TGraph::OnEdgesChanged()
+{
+	hierarchy = nullptr;
+	version++;
+}
+
+void TGraph::InsertCsrEdge(int aFromId, int aToId, float aWeight)
+{
+	// Forward: first in aFromId's range. Reverse: ranges are ordered by source, and the new edge is the first of its source.
+	InsertIntoRange(csrOffsets, csrTargets, csrWeights, aFromId, csrOffsets[aFromId], static_cast<uint32_t>(aToId), aWeight);
+	uint32_t reverseSlot = reverseOffsets[aToId];
+	while (reverseSlot < reverseOffsets[aToId + 1] && reverseSources[static_cast<int>(reverseSlot)] < static_cast<uint32_t>(aFromId))
+	{
+		reverseSlot++;
+	}
+	InsertIntoRange(reverseOffsets, reverseSources, reverseWeights, aToId, reverseSlot, static_cast<uint32_t>(aFromId), aWeight);
+}
+
+int TGraph::EraseCsrEdges(int aFromId, int aToId)
+{
+	EraseFromRange(reverseOffsets, reverseSources, reverseWeights, aToId, static_cast<uint32_t>(aFromId));
+	return EraseFromRange(csrOffsets, csrTargets, csrWeights, aFromId, static_cast<uint32_t>(aToId));
+}
+
+bool TGraph::UpdateEdge(const std::string& aFrom, const std::string& aTo, float aWeight, std::vector<TEdgeChange>* aOutChanges)
+{
+	TVertex* fromV = FindVertex(aFrom);
+	TVertex* toV = FindVertex(aTo);
+	if (fromV == nullptr || toV == nullptr)
+	{
+		std::cerr << "Error: City '" << (fromV == nullptr ? aFrom : aTo) << "' not found." << std::endl;
+		return false;
+	}
+
+	// Rewrite the weight wherever the edge is stored: edge lists (unfrozen) and CSR (if built)
+	bool isFound = false;
+	bool isLowered = false;
+	for (TEdge* e = fromV->edges; e != nullptr; e = e->next)
+	{
+		if (e->destination == toV)
+		{
+			isLowered = isLowered || aWeight < e->weight;
+			e->weight = aWeight;
+			isFound = true;
+		}
+	}
+	if (isCsrCurrent)
+	{
+		for (uint32_t e = csrOffsets[fromV->id]; e < csrOffsets[fromV->id + 1]; e++)
+		{
+			if (csrTargets[static_cast<int>(e)] == static_cast<uint32_t>(toV->id))
+			{
+				isLowered = isLowered || aWeight < csrWeights[static_cast<int>(e)];
+				csrWeights[static_cast<int>(e)] = aWeight;
+				isFound = true;
+			}
+		}
+		for (uint32_t e = reverseOffsets[toV->id]; e < reverseOffsets[toV->id + 1]; e++)
+		{
+			if (reverseSources[static_cast<int>(e)] == static_cast<uint32_t>(fromV->id))
+			{
+				reverseWeights[static_cast<int>(e)] = aWeight;
+			}
+		}
+	}
+	if (!isFound)
+	{
+		std::cerr << "Error: No edge from '" << aFrom << "' to '" << aTo << "'." << std::endl;
+		return false;
+	}
+
+	if (isLowered)
+	{
+		landmarkCount = 0;
+	}
+	TrackWeight(aWeight);
+	OnEdgesChanged();
+	if (aOutChanges != nullptr)
+	{
+		aOutChanges->push_back({ fromV->id, toV->id });
+	}
+	return true;
+}
+
+bool TGraph::RemoveEdge(const std::string& aFrom, const std::string& aTo, std::vector<TEdgeChange>* aOutChanges)
+{
+	TVertex* fromV = FindVertex(aFrom);
+	TVertex* toV = FindVertex(aTo);
+	if (fromV == nullptr || toV == nullptr)
+	{
+		std::cerr << "Error: City '" << (fromV == nullptr ? aFrom : aTo) << "' not found." << std::endl;
+		return false;
+	}
+
+	int removed = 0;
+	if (isFrozen)
+	{
+		removed = EraseCsrEdges(fromV->id, toV->id);
+	}
+	else
+	{
+		// Unlink the matching nodes from the edge list
+		EnsureEdgeLists();
+		TEdge** link = &fromV->edges;
+		while (*link != nullptr)
+		{
+			TEdge* e = *link;
+			if (e->destination == toV)
+			{
+				*link = e->next;
+				delete e;
+				removed++;
+			}
+			else
+			{
+				link = &e->next;
+			}
+		}
+		if (removed > 0)
+		{
+			isCsrCurrent = false;
+		}
+	}
+	if (removed == 0)
+	{
+		std::cerr << "Error: No edge from '" << aFrom << "' to '" << aTo << "'." << std::endl;
+		return false;
+	}
+
+	edgeCount -= removed;
+	OnEdgesChanged();
+	if (aOutChanges != nullptr)
+	{
+		aOutChanges->push_back({ fromV->id, toV->id });
+	}
+	return true;
+}
+
+bool TGraph::RemoveVertex(const std::string& aName, std::vector<TEdgeChange>* aOutChanges)
+{
+	TVertex* vertex = FindVertex(aName);
+	if (vertex == nullptr)
+	{
+		std::cerr << "Error: City '" << aName << "' not found." << std::endl;
+		return false;
+	}
+	int id = vertex->id;
+
+	// Collect every neighbour pair before the edges are gone
+	EnsureAdjacency();
+	TArrayWrapper<TEdgeChange> pairs;
+	for (uint32_t e = csrOffsets[id]; e < csrOffsets[id + 1]; e++)
+	{
+		pairs.Add({ id, static_cast<int>(csrTargets[static_cast<int>(e)]) });
+	}
+	for (uint32_t e = reverseOffsets[id]; e < reverseOffsets[id + 1]; e++)
+	{
+		pairs.Add({ static_cast<int>(reverseSources[static_cast<int>(e)]), id });
+	}
+	if (aOutChanges != nullptr)
+	{
+		aOutChanges->insert(aOutChanges->end(), pairs.begin(), pairs.end());
+	}
+
+	int removed = 0;
+	if (isFrozen)
+	{
+		// Parallel edges appear once per edge in pairs; the first erase takes them all
+		for (const TEdgeChange& pair : pairs)
+		{
+			removed += EraseCsrEdges(pair.fromId, pair.toId);
+		}
+	}
+	else
+	{
+		EnsureEdgeLists();
+		for (int i = 0; i < vertexCount; i++)
+		{
+			TEdge** link = &vertexById[i]->edges;
+			while (*link != nullptr)
+			{
+				TEdge* e = *link;
+				if (i == id || e->destination == vertex)
+				{
+					*link = e->next;
+					delete e;
+					removed++;
+				}
+				else
+				{
+					link = &e->next;
+				}
+			}
+		}
+		if (removed > 0)
+		{
+			isCsrCurrent = false;
+		}
+	}
+
+	edgeCount -= removed;
+	OnEdgesChanged();
+	return true;
+}
+
+void TGraph::ResetState()
+{
+	defaultContext.Begin(vertexCount, -1);
+}
+
+bool TGraph::RunDijkstra(const std::string& aStartCity)
+{
+	// Build the CSR here, so the const overload finds the graph ready
+	EnsureAdjacency();
+	if (LoadCachedTable(aStartCity))
+	{
+		return true;
+	}
+	if (!RunDijkstra(aStartCity, defaultContext))
+	{
+		return false;
+	}
+	if (routingCache != nullptr)
+	{
+		routingCache->Store(defaultContext, version);
+	}
+	return true;
+}
+
+bool TGraph::LoadCachedTable(const std::string& aStartCity)
+{
+	if (routingCache == nullptr)
+	{
+		return false;
+	}
+	int startId = GetVertexId(aStartCity);
+	return startId >= 0 && routingCache->Load(startId, version, defaultContext);
+}
+
+bool TGraph::RunDijkstra(const std::string& aStartCity, TQueryContext& aContext) const
+{
+	// 1. Find Start Node
+	TVertex* startNode = FindVertex(aStartCity);
+	if (startNode == nullptr)
+	{
+		std::cerr << "Error: Start city '" << aStartCity << "' not found." << std::endl;
+		return false;
+	}
+	if (!isCsrCurrent)
+	{
+		std::cerr << "Error: The graph changed since it was frozen; call Freeze() before querying it." << std::endl;
+		return false;
+	}
+
+	// 2. Reset (lazily, by generation)
+	aContext.Begin(vertexCount, startNode->id);
+
+	// 3. Run
+	Search(startNode->id, aContext);
+
+	return true;
+}
+
+void TGraph::Search(int aStartId, TQueryContext& aContext) const
+{
+	// Run with the queue that fits the weights
+	switch (ChooseQueue())
+	{
+	case EDijkstraQueue::BucketQueue:
+		RunMonotoneDijkstra(aStartId, aContext, aContext.GetBucketQueue(static_cast<uint32_t>(maxEdgeWeight)));
+		break;
+	case EDijkstraQueue::RadixHeap:
+		RunMonotoneDijkstra(aStartId, aContext, aContext.GetRadixHeap());
+		break;
+	default:
+		RunHeapDijkstra(aStartId, aContext);
+		break;
+	}
+}
+
+void TGraph::BuildRoute(const TQueryContext& aContext, int aTargetId, TRoute& aOutRoute) const
+{
+	aOutRoute.vertices.clear();
+	aOutRoute.isReachable = aContext.IsSettled(aTargetId);
+	aOutRoute.cost = aContext.GetDistance(aTargetId);
+	if (!aOutRoute.isReachable)
+	{
+		return;
+	}
+	// Walk back to the start, then turn the list around
+	for (int v = aTargetId; v >= 0; v = aContext.GetParent(v))
+	{
+		aOutRoute.vertices.push_back(v);
+	}
+	for (std::size_t i = 0, j = aOutRoute.vertices.size() - 1; i < j; i++, j--)
+	{
+		std::swap(aOutRoute.vertices[i], aOutRoute.vertices[j]);
+	}
+}
+
+bool TGraph::ShortestPath(const std::string& aFrom, const std::string& aTo, TRoute& aOutRoute)
+{
+	PrepareForConcurrentQueries();
+	return ShortestPath(aFrom, aTo, aOutRoute, defaultContext);
+}
+
+bool TGraph::ShortestPath(const std::string& aFrom, const std::string& aTo, TRoute& aOutRoute, TQueryContext& aContext) const
+{
+	aOutRoute = TRoute();
+
+	// 1. Find both cities
+	TVertex* startNode = FindVertex(aFrom);
+	TVertex* targetNode = FindVertex(aTo);
+	if (startNode == nullptr || targetNode == nullptr)
+	{
+		std::cerr << "Error: City '" << (startNode == nullptr ? aFrom : aTo) << "' not found." << std::endl;
+		return false;
+	}
+
+	// 2. Search until the destination is settled, and read the route off the parent links
+	return ShortestPath(startNode->id, targetNode->id, aOutRoute, aContext);
+}
+
+bool TGraph::ShortestPath(int aStartId, int aTargetId, TRoute& aOutRoute, TQueryContext& aContext) const
+{
+	aOutRoute = TRoute();
+	if (aStartId < 0 || aStartId >= vertexCount || aTargetId < 0 || aTargetId >= vertexCount)
+	{
+		return false;
+	}
+	if (!isCsrCurrent)
+	{
+		std::cerr << "Error: The graph changed since it was frozen; call Freeze() before querying it." << std::endl;
+		return false;
+	}
+	RunPointQuery(aStartId, aTargetId, aContext, aOutRoute);
+	return true;
+}
+
+void TGraph::RunPointQuery(int aStartId, int aTargetId, TQueryContext& aContext, TRoute& aOutRoute) const
+{
+	aContext.Begin(vertexCount, aStartId);
+	if (routeAlgorithm == ERouteAlgorithm::Bidirectional)
+	{
+		RunBidirectionalSearch(aStartId, aTargetId, aContext, aOutRoute);
+		return;
+	}
+	if (routeAlgorithm == ERouteAlgorithm::Landmarks)
+	{
+		RunLandmarkSearch(aStartId, aTargetId, aContext, aOutRoute);
+		return;
+	}
+	if (routeAlgorithm == ERouteAlgorithm::ContractionHierarchy && hierarchy != nullptr)
+	{
+		aOutRoute.isReachable = hierarchy->Query(aStartId, aTargetId, aContext, aOutRoute.vertices, aOutRoute.cost);
+		return;
+	}
+	aContext.AddTarget(aTargetId);
+	Search(aStartId, aContext);
+	BuildRoute(aContext, aTargetId, aOutRoute);
+}
+
+void TGraph::RunBidirectionalSearch(int aStartId, int aTargetId, TQueryContext& aContext, TRoute& aOutRoute) const
+{
+	// 1. One search forward from the start, one backward from the target (over the reverse CSR)
+	TQueryContext& forward = aContext;
+	TQueryContext& backward = aContext.GetBackward();
+	backward.Begin(vertexCount, aTargetId);
+	forward.SetLabel(aStartId, 0.0f, -1);
+	backward.SetLabel(aTargetId, 0.0f, -1);
+	forward.GetHeap().Enqueue(aStartId, 0.0f);
+	backward.GetHeap().Enqueue(aTargetId, 0.0f);
+
+	// Best start -> target distance seen so far, via the edge meetFrom -> meetTo
+	float best = (aStartId == aTargetId) ? 0.0f : std::numeric_limits<float>::infinity();
+	int meetFrom = aStartId;
+	int meetTo = aTargetId;
+
+	// 2. Expand the side with the smaller queue until the tops cannot beat the best meeting
+	while (!forward.GetHeap().IsEmpty() && !backward.GetHeap().IsEmpty())
+	{
+		if (forward.GetHeap().PeekPriority() + backward.GetHeap().PeekPriority() >= best)
+		{
+			break;
+		}
+		bool isForward = forward.GetHeap().GetCount() <= backward.GetHeap().GetCount();
+		TQueryContext& side = isForward ? forward : backward;
+		const TQueryContext& other = isForward ? backward : forward;
+		const uint32_t* offsets = isForward ? csrOffsets.GetData() : reverseOffsets.GetData();
+		const uint32_t* neighbours = isForward ? csrTargets.GetData() : reverseSources.GetData();
+		const float* weights = isForward ? csrWeights.GetData() : reverseWeights.GetData();
+		TIndexedPriorityQueue<TQueryContext::kHeapArity>& pq = side.GetHeap();
+
+		int u = pq.Dequeue();
+		side.Settle(u);
+		float distanceOfU = side.GetDistance(u);
+
+		for (uint32_t e = offsets[u]; e < offsets[u + 1]; e++)
+		{
+			int v = static_cast<int>(neighbours[e]);
+			float distanceThroughU = distanceOfU + weights[e];
+
+			// Does this edge close a shorter start -> target path through the other search?
+			if (other.IsReached(v) && distanceThroughU + other.GetDistance(v) < best)
+			{
+				best = distanceThroughU + other.GetDistance(v);
+				meetFrom = isForward ? u : v;
+				meetTo = isForward ? v : u;
+			}
+
+			if (!side.IsSettled(v) && distanceThroughU < side.GetDistance(v))
+			{
+				side.SetLabel(v, distanceThroughU, u);
+				if (pq.Contains(v))
+				{
+					pq.DecreaseKey(v, distanceThroughU);
+				}
+				else
+				{
+					pq.Enqueue(v, distanceThroughU);
+				}
+			}
+		}
+	}
+
+	// 3. Route: start -> meetFrom (forward parents), then meetTo -> target (backward parents)
+	aOutRoute.vertices.clear();
+	aOutRoute.isReachable = best != std::numeric_limits<float>::infinity();
+	if (!aOutRoute.isReachable)
+	{
+		aOutRoute.cost = best;
+		return;
+	}
+	for (int v = meetFrom; v >= 0; v = forward.GetParent(v))
+	{
+		aOutRoute.vertices.push_back(v);
+	}
+	for (std::size_t i = 0, j = aOutRoute.vertices.size() - 1; i < j; i++, j--)
+	{
+		std::swap(aOutRoute.vertices[i], aOutRoute.vertices[j]);
+	}
+	if (meetTo != meetFrom)
+	{
+		for (int v = meetTo; v >= 0; v = backward.GetParent(v))
+		{
+			aOutRoute.vertices.push_back(v);
+		}
+	}
+	// Re-add the weights in path order, so the cost matches a one-directional search exactly
+	aOutRoute.cost = PathCost(aOutRoute.vertices);
+}
+
+uint64_t TAdjacencyView::ComputeHash() const
+{
+	uint64_t hash = HashString(std::string_view(reinterpret_cast<const char*>(offsets), sizeof(uint32_t) * (vertexCount + 1)));
+	hash = HashString(std::string_view(reinterpret_cast<const char*>(targets), sizeof(uint32_t) * edgeCount), hash);
+	return HashString(std::string_view(reinterpret_cast<const char*>(weights), sizeof(float) * edgeCount), hash);
+}
+
+void TGraph::PrepareForConcurrentQueries()
+{
+	EnsureAdjacency();
+	if (routeAlgorithm == ERouteAlgorithm::Landmarks && landmarkCount == 0)
+	{
+		PrepareLandmarks();
+	}
+}
+
+TAdjacencyView TGraph::GetAdjacency()
 {
-	// The list will hold the vertices, but we will handle deletion manually
-	// to ensure edges are deleted first.
+	EnsureAdjacency();
+	TAdjacencyView view;
+	view.vertexCount = vertexCount;
+	view.edgeCount = edgeCount;
+	view.offsets = csrOffsets.GetData();
+	view.targets = csrTargets.GetData();
+	view.weights = csrWeights.GetData();
+	view.reverseOffsets = reverseOffsets.GetData();
+	view.reverseSources = reverseSources.GetData();
+	view.reverseWeights = reverseWeights.GetData();
+	return view;
 }
 
-TGraph::~TGraph()
+void TGraph::RunLandmarkSearch(int aStartId, int aTargetId, TQueryContext& aContext, TRoute& aOutRoute) const
 {
-	// 1. Iterate over all vertices to delete their Edges
-	TLinkedListNode<TVertex*>* currentNode = allVertices.GetHead()->GetNext();
+	// A*: the queue is ordered by distance so far + lower bound on the rest.
+	// Context distances stay plain distances, so BuildRoute works as for Dijkstra.
+	TIndexedPriorityQueue<TQueryContext::kHeapArity>& pq = aContext.GetHeap();
+	aContext.AddTarget(aTargetId);
+	aContext.SetLabel(aStartId, 0.0f, -1);
+	pq.Enqueue(aStartId, LandmarkBound(aStartId, aTargetId));
 
-	while (currentNode != allVertices.GetTail())
+	const uint32_t* offsets = csrOffsets.GetData();
+	const uint32_t* targets = csrTargets.GetData();
+	const float* weights = csrWeights.GetData();
+	while (!pq.IsEmpty())
 	{
-		TVertex* v = currentNode->GetData();
-
-		// Delete the linked list of edges for this vertex
-		TEdge* currentEdge = v->edges;
-		while (currentEdge != nullptr)
+		int u = pq.Dequeue();
+		aContext.Settle(u);
+		if (aContext.AllTargetsSettled())
 		{
-			TEdge* temp = currentEdge;
-			currentEdge = currentEdge->next;
-			delete temp;
+			break;
 		}
+		float distanceOfU = aContext.GetDistance(u);
 
-		// Now it is safe to delete the vertex itself
-		delete v;
-
-		currentNode = currentNode->GetNext();
+		for (uint32_t e = offsets[u]; e < offsets[u + 1]; e++)
+		{
+			int v = static_cast<int>(targets[e]);
+			float distanceThroughU = distanceOfU + weights[e];
+			if (aContext.IsSettled(v) || !(distanceThroughU < aContext.GetDistance(v)))
+			{
+				continue;
+			}
+			float bound = LandmarkBound(v, aTargetId);
+			if (bound == std::numeric_limits<float>::infinity())
+			{
+				continue; // v cannot reach the target
+			}
+			aContext.SetLabel(v, distanceThroughU, u);
+			if (pq.Contains(v))
+			{
+				pq.DecreaseKey(v, distanceThroughU + bound);
+			}
+			else
+			{
+				pq.Enqueue(v, distanceThroughU + bound);
+			}
+		}
 	}
+	BuildRoute(aContext, aTargetId, aOutRoute);
+}
 
-	// 2. The TLinkedList destructor will run, but we've already cleaned up the data.
-	// (Assuming the list was initialized with isDataOwner = false, which is default)
+float TGraph::LandmarkBound(int aId, int aTargetId) const
+{
+	// d(v, t) >= d(L, t) - d(L, v) and d(v, t) >= d(v, L) - d(t, L) for every landmark L.
+	// Unreachable pairs give inf - inf = NaN, which never wins a comparison and is skipped.
+	const float* fromV = landmarkFrom.GetData() + static_cast<std::size_t>(aId) * landmarkCount;
+	const float* fromT = landmarkFrom.GetData() + static_cast<std::size_t>(aTargetId) * landmarkCount;
+	const float* toV = landmarkTo.GetData() + static_cast<std::size_t>(aId) * landmarkCount;
+	const float* toT = landmarkTo.GetData() + static_cast<std::size_t>(aTargetId) * landmarkCount;
+	float bound = 0.0f;
+	for (int i = 0; i < landmarkCount; i++)
+	{
+		float viaFrom = fromT[i] - fromV[i];
+		float viaTo = toV[i] - toT[i];
+		if (viaFrom > bound) bound = viaFrom;
+		if (viaTo > bound) bound = viaTo;
+	}
+	return bound;
 }
 
-TVertex* TGraph::CreateVertex(const std::string& aName)
+bool TGraph::PrepareLandmarks(int aCount)
 {
-	// 1. Check if it exists
-	TVertex* existing = nullptr;
-	if (vertexLookup.Search(aName, existing))
+	EnsureAdjacency();
+	landmarkCount = 0;
+	if (vertexCount == 0 || aCount <= 0)
 	{
-		return existing;
+		return false;
+	}
+	if (aCount > vertexCount)
+	{
+		aCount = vertexCount;
 	}
 
-	// 2. Create new
-	TVertex* newVertex = new TVertex(aName);
+	const float kInfinity = std::numeric_limits<float>::infinity();
+	landmarkIds.Clear();
+	landmarkFrom.Clear();
+	landmarkTo.Clear();
+	landmarkFrom.Resize(vertexCount * aCount, kInfinity);
+	landmarkTo.Resize(vertexCount * aCount, kInfinity);
 
-	// 3. Add to storage (List) and Lookup (BST)
-	allVertices.Append(newVertex);
-	vertexLookup.Insert(aName, newVertex);
-	vertexCount++;
+	// closeness[v] = min over chosen landmarks of d(L -> v) + d(v -> L); the next landmark maximises it
+	TArrayWrapper<float> closeness(vertexCount);
+	closeness.Resize(vertexCount, kInfinity);
+	TQueryContext context;
 
-	return newVertex;
+	// 1. The first landmark is the vertex farthest from vertex 0
+	context.Begin(vertexCount, 0);
+	RunHeapDijkstra(0, context);
+	int candidate = 0;
+	for (int v = 0; v < vertexCount; v++)
+	{
+		float distance = context.GetDistance(v);
+		if (distance != kInfinity && distance > context.GetDistance(candidate))
+		{
+			candidate = v;
+		}
+	}
+
+	// 2. Farthest-first: each new landmark is the vertex least covered by the ones before it
+	for (int i = 0; i < aCount; i++)
+	{
+		landmarkIds.Add(candidate);
+		closeness[candidate] = -1.0f; // Never picked again
+
+		context.Begin(vertexCount, candidate);
+		RunHeapDijkstra(candidate, context);
+		for (int v = 0; v < vertexCount; v++)
+		{
+			landmarkFrom[v * aCount + i] = context.GetDistance(v);
+		}
+		context.Begin(vertexCount, candidate);
+		RunHeapDijkstra(candidate, context, true);
+		for (int v = 0; v < vertexCount; v++)
+		{
+			landmarkTo[v * aCount + i] = context.GetDistance(v);
+		}
+
+		candidate = -1;
+		for (int v = 0; v < vertexCount; v++)
+		{
+			if (closeness[v] < 0.0f) continue;
+			float roundTrip = landmarkFrom[v * aCount + i] + landmarkTo[v * aCount + i];
+			if (roundTrip < closeness[v])
+			{
+				closeness[v] = roundTrip;
+			}
+			if (candidate < 0 || closeness[v] > closeness[candidate])
+			{
+				candidate = v;
+			}
+		}
+		if (candidate < 0) break; // Every vertex is a landmark
+	}
+
+	landmarkCount = aCount;
+	return true;
 }
 
-void TGraph::AddEdge(const std::string& aFrom, const std::string& aTo, float aWeight)
+float TGraph::PathCost(const std::vector<int>& aVertices) const
 {
-	// Ensure both vertices exist
-	TVertex* fromV = CreateVertex(aFrom);
-	TVertex* toV = CreateVertex(aTo);
+	float cost = 0.0f;
+	for (std::size_t i = 1; i < aVertices.size(); i++)
+	{
+		int u = aVertices[i - 1];
+		float cheapest = std::numeric_limits<float>::infinity();
+		for (uint32_t e = csrOffsets[u]; e < csrOffsets[u + 1]; e++)
+		{
+			if (static_cast<int>(csrTargets[e]) == aVertices[i] && csrWeights[e] < cheapest)
+			{
+				cheapest = csrWeights[e];
+			}
+		}
+		cost += cheapest;
+	}
+	return cost;
+}
 
-	// Add the directed edge
-	fromV->AddEdge(toV, aWeight);
+int TGraph::ShortestPaths(const std::vector<std::pair<std::string, std::string>>& aQueries, std::vector<TRoute>& aOutRoutes, int aThreadCount)
+{
+	PrepareForConcurrentQueries();
+	std::vector<std::pair<int, int>> ids(aQueries.size());
+	for (std::size_t i = 0; i < aQueries.size(); i++)
+	{
+		ids[i] = { GetVertexId(aQueries[i].first), GetVertexId(aQueries[i].second) };
+	}
+	TThreadPool pool(aThreadCount);
+	std::vector<TQueryContext> contexts(static_cast<std::size_t>(pool.GetThreadCount()));
+	return ShortestPaths(ids, aOutRoutes, pool, contexts);
 }
 
-void TGraph::ResetState()
+int TGraph::ShortestPaths(const std::vector<std::pair<int, int>>& aQueries, std::vector<TRoute>& aOutRoutes, TThreadPool& aPool,
+	std::vector<TQueryContext>& aContexts, std::vector<float>* aOutMicroseconds) const
 {
-	TLinkedListNode<TVertex*>* currentNode = allVertices.GetHead()->GetNext();
-	while (currentNode != allVertices.GetTail())
+	aOutRoutes.assign(aQueries.size(), TRoute());
+	if (aOutMicroseconds != nullptr)
 	{
-		TVertex* v = currentNode->GetData();
-		v->minDistance = std::numeric_limits<float>::infinity();
-		v->previous = nullptr;
-		v->visited = false;
+		aOutMicroseconds->assign(aQueries.size(), 0.0f);
+	}
+	if (!isCsrCurrent)
+	{
+		std::cerr << "Error: The graph changed since it was frozen; call Freeze() before querying it." << std::endl;
+		return 0;
+	}
 
-		currentNode = currentNode->GetNext();
+	// 1. Count the valid queries per start city
+	auto isValid = [this](int aId) { return aId >= 0 && aId < vertexCount; };
+	std::vector<int> startOffsets(static_cast<std::size_t>(vertexCount) + 1, 0);
+	for (const std::pair<int, int>& query : aQueries)
+	{
+		if (isValid(query.first) && isValid(query.second))
+		{
+			startOffsets[static_cast<std::size_t>(query.first) + 1]++;
+		}
+	}
+
+	// 2. Counting sort by start city (O(queries + vertices) whatever the input order, and stable):
+	// the queries of group g are order[groupStarts[g]] .. order[groupStarts[g + 1] - 1]
+	for (std::size_t v = 0; v < static_cast<std::size_t>(vertexCount); v++)
+	{
+		startOffsets[v + 1] += startOffsets[v];
+	}
+	std::vector<int> order(static_cast<std::size_t>(startOffsets.back()));
+	std::vector<int> fill(startOffsets.begin(), startOffsets.end() - 1);
+	for (std::size_t i = 0; i < aQueries.size(); i++)
+	{
+		if (isValid(aQueries[i].first) && isValid(aQueries[i].second))
+		{
+			order[static_cast<std::size_t>(fill[static_cast<std::size_t>(aQueries[i].first)]++)] = static_cast<int>(i);
+		}
+	}
+	std::vector<int> groupStarts;
+	for (std::size_t v = 0; v < static_cast<std::size_t>(vertexCount); v++)
+	{
+		if (startOffsets[v] < startOffsets[v + 1])
+		{
+			groupStarts.push_back(startOffsets[v]);
+		}
+	}
+	groupStarts.push_back(static_cast<int>(order.size()));
+	int groupCount = static_cast<int>(groupStarts.size()) - 1;
+
+	// 3. The pool takes groups one at a time; each group is one search with several targets
+	auto recordTime = [aOutMicroseconds](std::size_t aQuery, std::chrono::steady_clock::time_point aStart)
+	{
+		if (aOutMicroseconds != nullptr)
+		{
+			(*aOutMicroseconds)[aQuery] = std::chrono::duration<float, std::micro>(std::chrono::steady_clock::now() - aStart).count();
+		}
+	};
+	const TThreadPool::FParallelBody solveGroup = [&](int aGroup, int aThreadIndex)
+	{
+		TQueryContext& context = aContexts[static_cast<std::size_t>(aThreadIndex)];
+		int startId = aQueries[static_cast<std::size_t>(order[static_cast<std::size_t>(groupStarts[aGroup])])].first;
+		auto start = std::chrono::steady_clock::now();
+		if (routeAlgorithm != ERouteAlgorithm::Dijkstra)
+		{
+			// Only a plain Dijkstra can share one search between destinations
+			for (int k = groupStarts[aGroup]; k < groupStarts[aGroup + 1]; k++)
+			{
+				std::size_t query = static_cast<std::size_t>(order[static_cast<std::size_t>(k)]);
+				start = std::chrono::steady_clock::now();
+				RunPointQuery(startId, aQueries[query].second, context, aOutRoutes[query]);
+				recordTime(query, start);
+			}
+			return;
+		}
+		context.Begin(vertexCount, startId);
+		for (int k = groupStarts[aGroup]; k < groupStarts[aGroup + 1]; k++)
+		{
+			context.AddTarget(aQueries[static_cast<std::size_t>(order[static_cast<std::size_t>(k)])].second);
+		}
+		Search(startId, context);
+		for (int k = groupStarts[aGroup]; k < groupStarts[aGroup + 1]; k++)
+		{
+			std::size_t query = static_cast<std::size_t>(order[static_cast<std::size_t>(k)]);
+			BuildRoute(context, aQueries[query].second, aOutRoutes[query]);
+			recordTime(query, start);
+		}
+	};
+	aPool.ParallelFor(groupCount, solveGroup, 1);
+
+	int found = 0;
+	for (const TRoute& route : aOutRoutes)
+	{
+		if (route.isReachable) found++;
 	}
+	return found;
 }
 
-bool TGraph::RunDijkstra(const std::string& aStartCity)
+void TGraph::InitParallelLabels(std::vector<std::atomic<uint64_t>>& aLabels, int aStartId) const
+{
+	for (std::atomic<uint64_t>& label : aLabels)
+	{
+		label.store(PackLabel(std::numeric_limits<float>::infinity(), kNoParent), std::memory_order_relaxed);
+	}
+	aLabels[static_cast<std::size_t>(aStartId)].store(PackLabel(0.0f, kNoParent), std::memory_order_relaxed);
+}
+
+void TGraph::PublishParallelLabels(const std::vector<std::atomic<uint64_t>>& aLabels, int aStartId)
+{
+	defaultContext.Begin(vertexCount, aStartId);
+	for (int i = 0; i < vertexCount; i++)
+	{
+		uint64_t label = aLabels[static_cast<std::size_t>(i)].load(std::memory_order_relaxed);
+		float distance = LabelDistance(label);
+		if (distance == std::numeric_limits<float>::infinity())
+		{
+			continue;
+		}
+		defaultContext.SetLabel(i, distance, (LabelParent(label) == kNoParent) ? -1 : static_cast<int>(LabelParent(label)));
+		defaultContext.Settle(i);
+	}
+}
+
+bool TGraph::RunParallelDijkstra(const std::string& aStartCity, int aThreadCount, TArrayWrapper<TMultiQueueStats>* aOutStats)
 {
 	// 1. Find Start Node
-	TVertex* startNode = nullptr;
-	if (!vertexLookup.Search(aStartCity, startNode))
+	TVertex* startNode = FindVertex(aStartCity);
+	if (startNode == nullptr)
 	{
 		std::cerr << "Error: Start city '" << aStartCity << "' not found." << std::endl;
 		return false;
 	}
 
 	// 2. Reset
-	ResetState();
+	EnsureAdjacency();
+	if (aThreadCount <= 0)
+	{
+		aThreadCount = static_cast<int>(std::thread::hardware_concurrency());
+		if (aThreadCount <= 0) aThreadCount = 1;
+	}
 
-	// 3. Initialize Priority Queue
-	// Capacity estimation: V * 4 is usually safe for edge relaxations in sparse graphs,
-	// or we can just use a large number if we don't want to implement dynamic resizing.
-	int pqCapacity = (vertexCount * 10) + 100;
-	TPriorityQueue<TVertex*> pq(pqCapacity);
+	std::vector<std::atomic<uint64_t>> labels(static_cast<std::size_t>(vertexCount));
+	InitParallelLabels(labels, startNode->id);
 
-	// 4. Setup Start
-	startNode->minDistance = 0.0f;
-	pq.Enqueue(startNode, 0.0f);
+	// 3. Seed the queue. 'pending' counts items pushed but not yet fully processed,
+	// so it only reaches zero once no thread can produce more work.
+	TMultiQueue<int> queue(aThreadCount);
+	std::atomic<long long> pending{ 1 };
+	queue.Push(0, startNode->id, 0.0f);
 
-	// 5. Process Loop
-	while (!pq.IsEmpty())
+	// 4. Workers pop approximately-smallest labels and relax with compare-and-swap
+	const uint32_t* offsets = csrOffsets.GetData();
+	const uint32_t* targets = csrTargets.GetData();
+	const float* weights = csrWeights.GetData();
+	auto worker = [&](int aThreadIndex)
+	{
+		int id = 0;
+		float distance = 0.0f;
+		while (pending.load(std::memory_order_acquire) > 0)
+		{
+			if (!queue.TryPop(aThreadIndex, id, distance))
+			{
+				std::this_thread::yield();
+				continue;
+			}
+
+			// Skip entries that were improved after they were queued
+			if (distance <= LabelDistance(labels[id].load(std::memory_order_acquire)))
+			{
+				for (uint32_t e = offsets[id]; e < offsets[id + 1]; e++)
+				{
+					int targetId = static_cast<int>(targets[e]);
+					float distanceThroughU = distance + weights[e];
+					uint64_t current = labels[targetId].load(std::memory_order_relaxed);
+					while (distanceThroughU < LabelDistance(current))
+					{
+						if (labels[targetId].compare_exchange_weak(current, PackLabel(distanceThroughU, static_cast<uint32_t>(id)),
+							std::memory_order_acq_rel, std::memory_order_relaxed))
+						{
+							pending.fetch_add(1, std::memory_order_acq_rel);
+							queue.Push(aThreadIndex, targetId, distanceThroughU);
+							break;
+						}
+					}
+				}
+			}
+			pending.fetch_sub(1, std::memory_order_acq_rel);
+		}
+	};
+
+	std::vector<std::thread> threads;
+	for (int i = 1; i < aThreadCount; i++)
+	{
+		threads.emplace_back(worker, i);
+	}
+	worker(0);
+	for (std::thread& thread : threads)
 	{
-		TVertex* u = pq.Dequeue();
+		thread.join();
+	}
 
-		// Optimization: If we extracted a node that was already visited/closed? 
-		// Dijkstra with simple PQ can add multiple entries for same node.
-		// We assume standard behavior here.
+	// 5. Publish the result into the default context, like RunDijkstra does
+	PublishParallelLabels(labels, startNode->id);
 
-		// Iterate Neighbors (Edges)
-		TEdge* e = u->edges;
-		while (e != nullptr)
+	if (aOutStats != nullptr)
+	{
+		aOutStats->Clear();
+		for (int i = 0; i < aThreadCount; i++)
 		{
-			TVertex* v = e->destination;
-			float weight = e->weight;
+			aOutStats->Add(queue.GetStats(i));
+		}
+	}
+	return true;
+}
 
-			// Relaxation Step
-			float distanceThroughU = u->minDistance + weight;
+float TGraph::GetDeltaSteppingDelta() const
+{
+	if (maxEdgeWeight <= 0.0f || vertexCount == 0)
+	{
+		return 1.0f;
+	}
+	float averageDegree = static_cast<float>(edgeCount) / static_cast<float>(vertexCount);
+	return (averageDegree > 1.0f) ? maxEdgeWeight / averageDegree : maxEdgeWeight;
+}
+
+bool TGraph::RunDeltaStepping(const std::string& aStartCity, float aDelta, int aThreadCount)
+{
+	// 1. Find Start Node
+	TVertex* startNode = FindVertex(aStartCity);
+	if (startNode == nullptr)
+	{
+		std::cerr << "Error: Start city '" << aStartCity << "' not found." << std::endl;
+		return false;
+	}
+
+	if (LoadCachedTable(aStartCity))
+	{
+		return true;
+	}
+
+	// 2. Pick the bucket width. Every queued distance is below (current bucket + 1) * delta + maxEdgeWeight,
+	// so a ring of maxEdgeWeight / delta + 3 buckets never wraps onto a live one. delta is a float like the
+	// edge weights, so the light/heavy split and the bucket index see exactly the same width.
+	EnsureAdjacency();
+	float delta = (aDelta > 0.0f) ? aDelta : GetDeltaSteppingDelta();
+	if (static_cast<double>(maxEdgeWeight) / delta > kMaxDeltaBuckets - 3)
+	{
+		delta = static_cast<float>(static_cast<double>(maxEdgeWeight) / (kMaxDeltaBuckets - 3));
+	}
+	int bucketCount = static_cast<int>(std::ceil(static_cast<double>(maxEdgeWeight) / delta)) + 3;
+	auto bucketOf = [delta](float aDistance)
+	{
+		return static_cast<long long>(static_cast<double>(aDistance) / delta);
+	};
+
+	TThreadPool pool(aThreadCount);
+	int threadCount = pool.GetThreadCount();
+
+	// 3. Labels as in RunParallelDijkstra: packed (distance, parent), improved with compare-and-swap
+	std::vector<std::atomic<uint64_t>> labels(static_cast<std::size_t>(vertexCount));
+	InitParallelLabels(labels, startNode->id);
+
+	// queuedBucket[v]: the bucket v is waiting in (-1 = none). A vertex moved to a lower bucket leaves
+	// a stale copy behind, recognised by this not matching. processedBucket[v]: last bucket that relaxed v.
+	std::vector<long long> queuedBucket(static_cast<std::size_t>(vertexCount), -1);
+	std::vector<long long> processedBucket(static_cast<std::size_t>(vertexCount), -1);
+	std::vector<std::vector<int>> buckets(static_cast<std::size_t>(bucketCount));
+	std::vector<std::vector<int>> improved(static_cast<std::size_t>(threadCount)); // Per thread, merged after each round
+	std::vector<int> frontier;
+	std::vector<int> bucketVertices; // Everything relaxed in the current bucket, for the heavy edges
+	long long queuedCount = 1;        // Bucket entries, stale ones included
+	buckets[0].push_back(startNode->id);
+	queuedBucket[startNode->id] = 0;
+
+	// 4. Relaxes the light or the heavy out-edges of frontier[aIndex]
+	const uint32_t* offsets = csrOffsets.GetData();
+	const uint32_t* targets = csrTargets.GetData();
+	const float* weights = csrWeights.GetData();
+	bool isLightRound = true;
+	auto relaxVertex = [&](int aIndex, int aThreadIndex)
+	{
+		int u = frontier[aIndex];
+		float distanceOfU = LabelDistance(labels[u].load(std::memory_order_acquire));
+		for (uint32_t e = offsets[u]; e < offsets[u + 1]; e++)
+		{
+			if ((weights[e] <= delta) != isLightRound)
+			{
+				continue;
+			}
+			int targetId = static_cast<int>(targets[e]);
+			float distanceThroughU = distanceOfU + weights[e];
+			uint64_t current = labels[targetId].load(std::memory_order_relaxed);
+			while (distanceThroughU < LabelDistance(current))
+			{
+				if (labels[targetId].compare_exchange_weak(current, PackLabel(distanceThroughU, static_cast<uint32_t>(u)),
+					std::memory_order_acq_rel, std::memory_order_relaxed))
+				{
+					improved[aThreadIndex].push_back(targetId);
+					break;
+				}
+			}
+		}
+	};
+	const TThreadPool::FParallelBody relaxBody = relaxVertex;
+	auto relaxFrontier = [&]()
+	{
+		int count = static_cast<int>(frontier.size());
+		if (count < kMinParallelFrontier)
+		{
+			for (int i = 0; i < count; i++)
+			{
+				relaxVertex(i, 0);
+			}
+		}
+		else
+		{
+			pool.ParallelFor(count, relaxBody, kDeltaSteppingChunkSize);
+		}
 
-			if (distanceThroughU < v->minDistance)
+		// Queue the improved vertices in the bucket of their new distance (once per bucket)
+		for (std::vector<int>& list : improved)
+		{
+			for (int v : list)
 			{
-				v->minDistance = distanceThroughU;
-				v->previous = u;
+				long long bucket = bucketOf(LabelDistance(labels[v].load(std::memory_order_relaxed)));
+				if (queuedBucket[v] != bucket)
+				{
+					queuedBucket[v] = bucket;
+					buckets[static_cast<std::size_t>(bucket % bucketCount)].push_back(v);
+					queuedCount++;
+				}
+			}
+			list.clear();
+		}
+	};
 
-				// Add to PQ
-				pq.Enqueue(v, v->minDistance);
+	// 5. Empty the buckets in order
+	long long currentBucket = 0;
+	while (queuedCount > 0)
+	{
+		std::vector<int>* bucket = &buckets[static_cast<std::size_t>(currentBucket % bucketCount)];
+		if (bucket->empty())
+		{
+			currentBucket++;
+			continue;
+		}
+
+		// Light edges can refill the current bucket, so repeat until it stays empty
+		bucketVertices.clear();
+		while (!bucket->empty())
+		{
+			frontier.clear();
+			for (int v : *bucket)
+			{
+				if (queuedBucket[v] == currentBucket)
+				{
+					queuedBucket[v] = -1;
+					frontier.push_back(v);
+					if (processedBucket[v] != currentBucket)
+					{
+						processedBucket[v] = currentBucket;
+						bucketVertices.push_back(v);
+					}
+				}
 			}
+			queuedCount -= static_cast<long long>(bucket->size());
+			bucket->clear();
 
-			e = e->next;
+			isLightRound = true;
+			relaxFrontier();
 		}
+
+		// The bucket's distances are final now; heavy edges only reach later buckets
+		frontier.swap(bucketVertices);
+		isLightRound = false;
+		relaxFrontier();
+		currentBucket++;
 	}
 
+	// 6. Publish the result into the default context, like RunDijkstra does
+	PublishParallelLabels(labels, startNode->id);
+	if (routingCache != nullptr)
+	{
+		routingCache->Store(defaultContext, version);
+	}
 	return true;
 }
 
+EDijkstraQueue TGraph::ChooseQueue() const
+{
+	// Integer keys are 32-bit, so the longest possible path must fit as well
+	bool integerQueuesUsable = hasIntegerWeights
+		&& static_cast<double>(maxEdgeWeight) * vertexCount < static_cast<double>(std::numeric_limits<uint32_t>::max());
+
+	switch (queueStrategy)
+	{
+	case EDijkstraQueue::RadixHeap:
+		return integerQueuesUsable ? EDijkstraQueue::RadixHeap : EDijkstraQueue::Heap;
+	case EDijkstraQueue::BucketQueue:
+		return integerQueuesUsable ? EDijkstraQueue::BucketQueue : EDijkstraQueue::Heap;
+	case EDijkstraQueue::Heap:
+		return EDijkstraQueue::Heap;
+	case EDijkstraQueue::Auto:
+	default:
+		if (!integerQueuesUsable)
+		{
+			return EDijkstraQueue::Heap;
+		}
+		return (maxEdgeWeight <= kMaxBucketQueueWeight) ? EDijkstraQueue::BucketQueue : EDijkstraQueue::RadixHeap;
+	}
+}
+
+void TGraph::RunHeapDijkstra(int aStartId, TQueryContext& aContext, bool aIsBackward) const
+{
+	// 1. Initialize Priority Queue
+	// Indexed by vertex id: a vertex is never queued twice, so V slots are always enough.
+	TIndexedPriorityQueue<TQueryContext::kHeapArity>& pq = aContext.GetHeap();
+
+	// 2. Setup Start
+	aContext.SetLabel(aStartId, 0.0f, -1);
+	pq.Enqueue(aStartId, 0.0f);
+
+	// 3. Process Loop
+	const uint32_t* offsets = aIsBackward ? reverseOffsets.GetData() : csrOffsets.GetData();
+	const uint32_t* targets = aIsBackward ? reverseSources.GetData() : csrTargets.GetData();
+	const float* weights = aIsBackward ? reverseWeights.GetData() : csrWeights.GetData();
+	while (!pq.IsEmpty())
+	{
+		int u = pq.Dequeue();
+		// Popped with its final distance; it will never be relaxed again
+		aContext.Settle(u);
+		if (aContext.AllTargetsSettled())
+		{
+			break;
+		}
+		float distanceOfU = aContext.GetDistance(u);
+
+		// Iterate Neighbors (a contiguous range of the CSR arrays)
+		for (uint32_t e = offsets[u]; e < offsets[u + 1]; e++)
+		{
+			int v = static_cast<int>(targets[e]);
+
+			// Relaxation Step
+			float distanceThroughU = distanceOfU + weights[e];
+
+			if (!aContext.IsSettled(v) && distanceThroughU < aContext.GetDistance(v))
+			{
+				aContext.SetLabel(v, distanceThroughU, u);
+
+				// Queue it, or move it up if it is already queued
+				if (pq.Contains(v))
+				{
+					pq.DecreaseKey(v, distanceThroughU);
+				}
+				else
+				{
+					pq.Enqueue(v, distanceThroughU);
+				}
+			}
+		}
+	}
+}
+
+template <typename TQueue>
+void TGraph::RunMonotoneDijkstra(int aStartId, TQueryContext& aContext, TQueue& aQueue) const
+{
+	// Exact integer distances while searching (float distances are derived from them)
+	aContext.SetIntegerLabel(aStartId, 0, -1);
+	aQueue.Enqueue(aStartId, 0);
+
+	const uint32_t* offsets = csrOffsets.GetData();
+	const uint32_t* targets = csrTargets.GetData();
+	const float* weights = csrWeights.GetData();
+
+	while (!aQueue.IsEmpty())
+	{
+		uint32_t key = 0;
+		int u = aQueue.Dequeue(key);
+
+		// These queues have no decrease-key, so skip the stale copies of settled vertices
+		if (aContext.IsSettled(u))
+		{
+			continue;
+		}
+		aContext.Settle(u);
+		if (aContext.AllTargetsSettled())
+		{
+			break;
+		}
+
+		for (uint32_t e = offsets[u]; e < offsets[u + 1]; e++)
+		{
+			int v = static_cast<int>(targets[e]);
+			uint32_t distanceThroughU = key + static_cast<uint32_t>(weights[e]);
+
+			if (!aContext.IsSettled(v) && distanceThroughU < aContext.GetIntegerDistance(v))
+			{
+				aContext.SetIntegerLabel(v, distanceThroughU, u);
+				aQueue.Enqueue(v, distanceThroughU);
+			}
+		}
+	}
+}
+
 void TGraph::PrintRoutingTable() const
+{
+	PrintRoutingTable(defaultContext);
+}
+
+void TGraph::PrintRoutingTable(const TQueryContext& aContext) const
 {
 	std::cout << "\n--- Routing Table (Lowest Cost from Source) ---\n";
 
@@ -150,13 +2506,15 @@ void TGraph::PrintRoutingTable() const
 
 		std::cout << "Destination: " << v->name;
 
-		if (v->minDistance == std::numeric_limits<float>::infinity())
+		// Vertices added after the query (or never searched) are unreachable as far as it knows
+		float distance = (v->id < aContext.GetVertexCount()) ? aContext.GetDistance(v->id) : std::numeric_limits<float>::infinity();
+		if (distance == std::numeric_limits<float>::infinity())
 		{
 			std::cout << " | Cost: [Unreachable]" << std::endl;
 		}
 		else
 		{
-			std::cout << " | Cost: " << v->minDistance << std::endl;
+			std::cout << " | Cost: " << distance << std::endl;
 		}
 
 		currentNode = currentNode->GetNext();
@@ -164,6 +2522,21 @@ void TGraph::PrintRoutingTable() const
 	std::cout << "-----------------------------------------------\n";
 }
 
+void TGraph::PrintRoute(const TRoute& aRoute) const
+{
+	if (!aRoute.isReachable)
+	{
+		std::cout << "Route: [Unreachable]" << std::endl;
+		return;
+	}
+	std::cout << "Route: ";
+	for (std::size_t i = 0; i < aRoute.vertices.size(); i++)
+	{
+		std::cout << (i > 0 ? " -> " : "") << vertexById[aRoute.vertices[i]]->name;
+	}
+	std::cout << " | Cost: " << aRoute.cost << std::endl;
+}
+
 // Inside TGraph.cpp
 
 void TGraph::PrintVertices() const
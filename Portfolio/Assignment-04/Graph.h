@@ -2,14 +2,30 @@
 #ifndef GRAPH_H
 #define GRAPH_H
 
+#include <atomic>
+#include <limits>
+#include <memory>
 #include <string>
+#include <string_view>
 #include <iostream>
+#include <utility>
 #include <vector> // Used only for returning the path/routing table
 #include "LinkedList.hpp"
-#include "BinarySearchTable.hpp"
+#include "HashMap.hpp"
+#include "PerfectHash.h"
+#include "MappedFile.h"
+#include "ArrayWrapper.hpp"
+#include "MultiQueue.hpp"
+#include "IndexedPriorityQueue.hpp"
+#include "RadixHeap.hpp"
+#include "BucketQueue.hpp"
 
 // Forward declaration
 struct TVertex;
+class TContractionHierarchy;
+class TRoutingCache;
+class TThreadPool;
+struct TEdgeBuffer;
 
 /**
  * @brief Represents a weighted connection to another city.
@@ -29,15 +45,11 @@ struct TEdge {
  */
 struct TVertex {
 	std::string name;
-	TEdge* edges; // Head of the adjacency list
+	int id;       // Dense index in [0, vertexCount): creation order, unless Freeze renumbered it (see EVertexOrder)
+	TEdge* edges; // Head of the adjacency list (nullptr while the graph is frozen, see TGraph::Freeze)
 
-	// --- Dijkstra Helper Fields ---
-	float minDistance;
-	TVertex* previous; // For path reconstruction
-	bool visited;
-
-	TVertex(std::string aName)
-		: name(aName), edges(nullptr), minDistance(1e9), previous(nullptr), visited(false) {
+	TVertex(std::string aName, int aId)
+		: name(aName), id(aId), edges(nullptr) {
 	}
 
 	// Helper to add an edge to this vertex's list
@@ -48,6 +60,188 @@ struct TVertex {
 	}
 };
 
+/**
+ * @brief Which priority queue RunDijkstra uses.
+ * Auto picks a monotone integer queue (bucket queue or radix heap) when every weight is a
+ * non-negative integer, and the 4-ary indexed heap otherwise.
+ */
+enum class EDijkstraQueue {
+	Auto,
+	Heap,
+	RadixHeap,
+	BucketQueue
+};
+
+/**
+ * @brief How Freeze numbers the vertices. The CSR arrays and every per-vertex array of a search are
+ * indexed by id, so numbering connected vertices close together keeps a search in fewer cache lines.
+ * Input keeps the creation (file) order. Bfs numbers them in breadth-first order over the edges in
+ * both directions. ReverseCuthillMcKee is a breadth-first order from a low-degree vertex that queues
+ * neighbours by increasing degree and is then reversed, which keeps the edges close to the diagonal.
+ * Degree numbers them by decreasing degree, so the hubs that most searches pass share cache lines.
+ */
+enum class EVertexOrder {
+	Input,
+	Bfs,
+	ReverseCuthillMcKee,
+	Degree
+};
+
+/**
+ * @brief Numeric graph files read by TGraph::LoadNumericGraph.
+ * Dimacs is the shortest-path format of the 9th DIMACS challenge (.gr): a "p sp N M" line, then one
+ * "a U V W" line per arc with ids 1..N; lines starting with 'c' are comments.
+ * EdgeList has one "U V [W]" line per edge (separated by spaces, tabs or commas) with ids from 0,
+ * and weight 1 where none is given; lines starting with '#' or '%' are comments.
+ */
+enum class ENumericGraphFormat {
+	Dimacs,
+	EdgeList
+};
+
+/**
+ * @brief How ShortestPath searches.
+ * Dijkstra grows one search from the start; Bidirectional grows a second one backwards from the
+ * destination over the reverse edges and stops when the two can no longer improve on the best meeting.
+ * Landmarks is A* guided by lower bounds from precomputed landmark distances (ALT, see PrepareLandmarks).
+ * ContractionHierarchy runs the upward query of an attached TContractionHierarchy (Dijkstra if none).
+ */
+enum class ERouteAlgorithm {
+	Dijkstra,
+	Bidirectional,
+	Landmarks,
+	ContractionHierarchy
+};
+
+/**
+ * @brief The state of one search: distance, parent and settled flag per vertex id, plus the queues.
+ * Entries are stamped with a generation number and only count if the stamp is current, so starting
+ * a new query bumps one counter instead of resetting every vertex. The graph is not written during a
+ * query, so several threads can search one graph at the same time, each with its own context.
+ */
+class TQueryContext {
+public:
+	// 4-ary heap: children of a node share a cache line and the heap is half as deep
+	static constexpr int kHeapArity = 4;
+
+private:
+	TArrayWrapper<uint32_t> stamps;           // Vertex id -> generation its entry was written in
+	TArrayWrapper<float> distances;
+	TArrayWrapper<uint32_t> integerDistances; // Exact distances for the monotone integer queues
+	TArrayWrapper<int> parents;               // -1 = no parent (the source)
+	TArrayWrapper<uint8_t> settled;
+	uint32_t generation;
+	int vertexCount;
+	int source;
+	int reachedCount;
+
+	// Queues are kept between queries so their storage is reused
+	TIndexedPriorityQueue<kHeapArity> heap;
+	TRadixHeap<int> radixHeap;
+	TBucketQueue<int> bucketQueue;
+
+	// Optional targets: the search may stop once all of them are settled
+	TArrayWrapper<uint32_t> targetStamps;
+	int remainingTargets;
+	bool hasTargets;
+
+	// State of the backward search of a bidirectional query, created on first use
+	std::unique_ptr<TQueryContext> backward;
+
+public:
+	TQueryContext();
+
+	/**
+	 * @brief Starts a new query over aVertexCount vertices. O(1) apart from growing and emptying the queues.
+	 */
+	void Begin(int aVertexCount, int aSource);
+
+	int GetVertexCount() const { return vertexCount; }
+	int GetSource() const { return source; }
+
+	/**
+	 * @brief Vertices that received a distance in this query (the work a reset would have to undo).
+	 */
+	int GetReachedCount() const { return reachedCount; }
+
+	// Hot accessors read the raw arrays (ids come from the graph, so they are in range)
+	bool IsReached(int aId) const { return stamps.GetData()[aId] == generation; }
+	bool IsSettled(int aId) const { return IsReached(aId) && settled.GetData()[aId] != 0; }
+
+	/**
+	 * @brief Tentative (or, once settled, final) distance; infinity if not reached.
+	 */
+	float GetDistance(int aId) const {
+		return IsReached(aId) ? distances.GetData()[aId] : std::numeric_limits<float>::infinity();
+	}
+	uint32_t GetIntegerDistance(int aId) const;
+	int GetParent(int aId) const;
+
+	void SetLabel(int aId, float aDistance, int aParent);
+	void SetIntegerLabel(int aId, uint32_t aDistance, int aParent);
+	void Settle(int aId);
+
+	/**
+	 * @brief Registers a vertex the query is looking for (call after Begin). Without targets a
+	 * search settles everything it can reach; with targets it stops once they are all settled.
+	 */
+	void AddTarget(int aId);
+
+	bool AllTargetsSettled() const { return hasTargets && remainingTargets == 0; }
+
+	/**
+	 * @brief The context for the backward half of a bidirectional query.
+	 */
+	TQueryContext& GetBackward();
+
+	TIndexedPriorityQueue<kHeapArity>& GetHeap() { return heap; }
+	TRadixHeap<int>& GetRadixHeap() { return radixHeap; }
+
+	/**
+	 * @brief The bucket queue, rebuilt if it was made for a different span.
+	 */
+	TBucketQueue<int>& GetBucketQueue(uint32_t aMaxSpan);
+};
+
+/**
+ * @brief Read-only view of a graph's CSR adjacency, for algorithms that live outside TGraph.
+ * The out-edges of vertex v are [offsets[v], offsets[v + 1]) in targets / weights.
+ */
+struct TAdjacencyView {
+	int vertexCount;
+	int edgeCount;
+	const uint32_t* offsets;
+	const uint32_t* targets;
+	const float* weights;
+	// The same edges by target: the edges into v are [reverseOffsets[v], reverseOffsets[v + 1]) in reverseSources / reverseWeights
+	const uint32_t* reverseOffsets;
+	const uint32_t* reverseSources;
+	const float* reverseWeights;
+
+	/**
+	 * @brief Hash over the whole adjacency; files derived from a graph store it to detect a changed graph.
+	 */
+	uint64_t ComputeHash() const;
+};
+
+/**
+ * @brief A (from, to) vertex pair whose edges were added, reweighted or removed.
+ * The editing methods of TGraph can append these, so shortest path trees can be repaired (see TDynamicShortestPaths).
+ */
+struct TEdgeChange {
+	int fromId;
+	int toId;
+};
+
+/**
+ * @brief A shortest route between two cities, as returned by TGraph::ShortestPath.
+ */
+struct TRoute {
+	bool isReachable = false;
+	float cost = 0.0f;
+	std::vector<int> vertices; // Vertex ids from start to destination (empty if unreachable)
+};
+
 /**
  * @brief Adjacency List Graph with Dijkstra capabilities.
  */
@@ -56,17 +250,235 @@ private:
 	// 1. Data Ownership: Use a Linked List to hold all vertices so we can delete them.
 	TLinkedList<TVertex*> allVertices;
 
-	// 2. Fast Lookup: Map "CityName" -> TVertex*
-	TBinarySearchTable<TVertex*> vertexLookup;
+	// 2. Fast Lookup: Map "CityName" -> TVertex* (open-addressing hash map, O(1) average)
+	THashMap<TVertex*> vertexLookup;
+
+	// 3. Id Lookup: vertexById[v->id] == v, used to map queue ids back to vertices
+	TArrayWrapper<TVertex*> vertexById;
 
-	// 3. Count of vertices (useful for init PriorityQueue)
+	// 4. Count of vertices (useful for init PriorityQueue)
 	int vertexCount;
 
+	// 5. Weight profile, kept up to date by AddEdge so RunDijkstra can pick an integer queue
+	bool hasIntegerWeights;
+	float maxEdgeWeight;
+	EDijkstraQueue queueStrategy;
+
+	// 6. Frozen name index (see Freeze): perfect-hash slot -> vertex id.
+	// slotToId points into slotToIdStorage, or into nameIndexFile when loaded from disk.
+	bool isFrozen;
+	TMinimalPerfectHash nameIndex;
+	TArrayWrapper<uint32_t> slotToIdStorage;
+	const uint32_t* slotToId;
+	TMappedFile nameIndexFile;
+
+	// 7. CSR adjacency (compressed sparse row) that all queries run on.
+	// The edges of vertex v are [csrOffsets[v], csrOffsets[v + 1]) in csrTargets / csrWeights,
+	// in the same order as v's edge list. Rebuilt from the edge lists when an edge was added.
+	TArrayWrapper<uint32_t> csrOffsets;
+	TArrayWrapper<uint32_t> csrTargets;
+	TArrayWrapper<float> csrWeights;
+	// The same edges reversed: the edges into v are [reverseOffsets[v], reverseOffsets[v + 1]) in reverseSources / reverseWeights
+	TArrayWrapper<uint32_t> reverseOffsets;
+	TArrayWrapper<uint32_t> reverseSources;
+	TArrayWrapper<float> reverseWeights;
+	bool isCsrCurrent;
+	int edgeCount;
+	// False while the CSR holds the only copy of the edges: frozen, or bulk-loaded and not edited since
+	bool hasEdgeLists;
+
+	/**
+	 * @brief Drops the frozen index and goes back to the hash map and edge lists (the graph is changing).
+	 */
+	void Thaw();
+
+	/**
+	 * @brief Builds the CSR arrays from the edge lists if an edge was added since the last build.
+	 */
+	void EnsureAdjacency();
+
+	/**
+	 * @brief Builds the reverse CSR from the forward one.
+	 */
+	void BuildReverseAdjacency();
+
+	/**
+	 * @brief Builds the perfect hash over the names and its slot -> id table (used by Freeze).
+	 * @return False if the names are not distinct.
+	 */
+	bool BuildNameIndex();
+
+	/**
+	 * @brief Deletes the TEdge lists; the CSR arrays then hold the only copy of the edges.
+	 */
+	void ReleaseEdgeLists();
+
+	/**
+	 * @brief Recreates the TEdge lists from the CSR arrays, in the original order.
+	 */
+	void RestoreEdgeLists();
+
+	/**
+	 * @brief Recreates the TEdge lists of a bulk-loaded graph before the first edit that works on them.
+	 */
+	void EnsureEdgeLists();
+
+	/**
+	 * @brief Hash over all names in id order; an index file is only valid for the same set and order.
+	 */
+	uint64_t ComputeNameSetHash() const;
+
+	/**
+	 * @brief Looks up a vertex by name, or returns nullptr.
+	 */
+	TVertex* FindVertex(std::string_view aName) const;
+
+	/**
+	 * @brief Resolves Auto (or an integer queue that cannot be used) to the queue to run.
+	 */
+	EDijkstraQueue ChooseQueue() const;
+
+	// 8. Search state of the single-threaded API (RunDijkstra(name), PrintRoutingTable())
+	TQueryContext defaultContext;
+	ERouteAlgorithm routeAlgorithm;
+
+	// 9. ALT landmarks (see PrepareLandmarks). Distances are stored vertex-major, so the bound for
+	// one vertex reads landmarkCount consecutive floats: landmarkFrom[v * landmarkCount + i] = d(landmark i -> v),
+	// landmarkTo[v * landmarkCount + i] = d(v -> landmark i). landmarkCount is 0 when there are none (or they are stale).
+	int landmarkCount;
+	TArrayWrapper<int> landmarkIds;
+	TArrayWrapper<float> landmarkFrom;
+	TArrayWrapper<float> landmarkTo;
+
+	// 10. Contraction hierarchy used by ERouteAlgorithm::ContractionHierarchy (not owned; dropped when the graph changes)
+	const TContractionHierarchy* hierarchy;
+
+	// 11. Bumped by every change to the vertices or edges
+	uint64_t version;
+
+	// 12. Cache of full routing tables used by RunDijkstra(name) and RunDeltaStepping (not owned; keyed by version, so it survives edits)
+	TRoutingCache* routingCache;
+
+	// 13. Vertex numbering (see EVertexOrder): inputIndexById[v->id] is v's position in creation order.
+	// The ids were last numbered by orderedBy, for the graph as it was at orderedVersion.
+	EVertexOrder vertexOrder;
+	TArrayWrapper<int> inputIndexById;
+	EVertexOrder orderedBy;
+	uint64_t orderedVersion;
+
+	/**
+	 * @brief Gives vertexById[aOrder[i]] the id i, permutes the CSR to match and drops what was built on the old ids.
+	 * The edge lists (if any) point at vertices, so they need no change.
+	 */
+	void RenumberVertices(const TArrayWrapper<int>& aOrder);
+
+	/**
+	 * @brief Numbers the vertices by vertexOrder, unless they already are (called by Freeze and LoadNameIndex).
+	 */
+	void ApplyVertexOrder();
+
+	/**
+	 * @brief Builds the CSR of a bulk load straight from parsed edges (counting sort by source), then frees the buffers.
+	 * Each vertex keeps its edges in buffer order, so the result does not depend on how the chunks were spread over threads.
+	 * @param aIsReversed True for the reverse of buffer order, the order edge lists built by AddEdge have.
+	 */
+	void BuildCsrFromBuffers(std::vector<TEdgeBuffer>& aBuffers, bool aIsReversed);
+
+	/**
+	 * @brief Inserts the edge aFromId -> aToId into the forward and reverse CSR in place (frozen graphs only).
+	 * It goes first in aFromId's range, where a rebuild from the edge lists would put it.
+	 */
+	void InsertCsrEdge(int aFromId, int aToId, float aWeight);
+
+	/**
+	 * @brief Removes the edges aFromId -> aToId from both CSR directions in place (frozen graphs only).
+	 * @return The number of edges removed.
+	 */
+	int EraseCsrEdges(int aFromId, int aToId);
+
+	/**
+	 * @brief Called after every edit of an edge: detaches the hierarchy and bumps the version.
+	 */
+	void OnEdgesChanged();
+
+	/**
+	 * @brief Updates the weight profile (integer weights, largest weight) for a weight entering the graph.
+	 */
+	void TrackWeight(float aWeight);
+
+	/**
+	 * @brief Loads the cached routing table of aStartCity into the default context, if the cache has it.
+	 */
+	bool LoadCachedTable(const std::string& aStartCity);
+
+	/**
+	 * @brief Searches from aStartId into a context that has been begun (and given targets, if any).
+	 */
+	void Search(int aStartId, TQueryContext& aContext) const;
+
+	/**
+	 * @brief Follows the parent links of a finished search back from aTargetId.
+	 */
+	void BuildRoute(const TQueryContext& aContext, int aTargetId, TRoute& aOutRoute) const;
+
+	/**
+	 * @brief One point-to-point query with the current route algorithm (begins aContext itself).
+	 */
+	void RunPointQuery(int aStartId, int aTargetId, TQueryContext& aContext, TRoute& aOutRoute) const;
+
+	/**
+	 * @brief Resets the labels of a parallel search (packed distance and parent): the start at 0, the rest unreached.
+	 */
+	void InitParallelLabels(std::vector<std::atomic<uint64_t>>& aLabels, int aStartId) const;
+
+	/**
+	 * @brief Copies the labels of a finished parallel search into the default context, as RunDijkstra leaves it.
+	 */
+	void PublishParallelLabels(const std::vector<std::atomic<uint64_t>>& aLabels, int aStartId);
+
+	/**
+	 * @brief Bidirectional Dijkstra from aStartId to aTargetId over the forward and reverse CSR.
+	 */
+	void RunBidirectionalSearch(int aStartId, int aTargetId, TQueryContext& aContext, TRoute& aOutRoute) const;
+
+	/**
+	 * @brief A* from aStartId to aTargetId with the landmark lower bounds as the heuristic.
+	 */
+	void RunLandmarkSearch(int aStartId, int aTargetId, TQueryContext& aContext, TRoute& aOutRoute) const;
+
+	/**
+	 * @brief Lower bound on d(aId -> aTargetId) from the triangle inequality over all landmarks.
+	 * Infinity means aId cannot reach the target at all.
+	 */
+	float LandmarkBound(int aId, int aTargetId) const;
+
+	/**
+	 * @brief Sums the cheapest edge between each pair of consecutive vertices, in path order.
+	 */
+	float PathCost(const std::vector<int>& aVertices) const;
+
+	/**
+	 * @brief Dijkstra with the indexed heap (any non-negative float weights).
+	 * @param aIsBackward True to follow the reverse edges (distances *to* aStartId).
+	 */
+	void RunHeapDijkstra(int aStartId, TQueryContext& aContext, bool aIsBackward = false) const;
+
+	/**
+	 * @brief Dijkstra with a monotone integer queue (TRadixHeap or TBucketQueue) and lazy deletion.
+	 */
+	template <typename TQueue>
+	void RunMonotoneDijkstra(int aStartId, TQueryContext& aContext, TQueue& aQueue) const;
+
 public:
 	TGraph();
 	~TGraph();
 
 	// --- Building the Graph ---
+	/**
+	 * @brief Pre-sizes the vertex storage, e.g. from the [NODES;records:=N] header.
+	 */
+	void ReserveVertices(int aCount);
+
 	/**
 	 * @brief Creates a vertex if it doesn't exist.
 	 */
@@ -74,29 +486,268 @@ public:
 
 	/**
 	 * @brief Adds a directed weighted edge.
+	 * On a frozen graph an edge between existing cities is inserted into the CSR without thawing.
+	 * @param aOutChanges Optional; receives the changed vertex pair.
 	 */
-	void AddEdge(const std::string& aFrom, const std::string& aTo, float aWeight);
+	void AddEdge(const std::string& aFrom, const std::string& aTo, float aWeight, std::vector<TEdgeChange>* aOutChanges = nullptr);
+
+	/**
+	 * @brief Bulk-loads a numeric graph file (see ENumericGraphFormat) into an empty graph and freezes it.
+	 * The file is memory-mapped and parsed in chunks on aThreadCount threads (0 = one per hardware thread);
+	 * the edges go straight into the CSR, with no name lookups and no edge lists. Vertex i is named after
+	 * its id in the file, so "1" is the first vertex of a DIMACS file. Vertices without edges are kept.
+	 * @return False (leaving the graph empty) if the graph is not empty or the file cannot be read or parsed,
+	 * and false (leaving the graph loaded but unfrozen) if the name index cannot be built.
+	 */
+	bool LoadNumericGraph(const std::string& aFilename, ENumericGraphFormat aFormat, int aThreadCount = 0);
+
+	/**
+	 * @brief Bulk-loads a [NODES]/[EDGES] text file into an empty graph, as readGraphFromFile with CreateVertex
+	 * and AddEdge callbacks would, but without a name lookup or an allocation per edge.
+	 * A first pass on one thread gives every [NODES] name its id in the hash map; the [EDGES] lines are then
+	 * parsed on aThreadCount threads (0 = one per hardware thread) into per-chunk (from, to, weight) buffers,
+	 * and the CSR is built from them by a degree count, a prefix sum and a scatter. Cities named only by edges
+	 * get their ids in file order after the [NODES] ones, so the ids and the edge order match the callbacks
+	 * unless an [EDGES] section comes before a [NODES] section. Lines the callbacks skip are skipped.
+	 * The graph is left unfrozen (Freeze or LoadNameIndex next); its edge lists are only built if an edit needs them.
+	 * @return False if the graph is not empty, the file cannot be read or it has more edges than an int counts.
+	 */
+	bool LoadTextGraph(const std::string& aFilename, int aThreadCount = 0);
+
+	// --- Editing ---
+	// A frozen graph is edited in place; an unfrozen one edits its edge lists and rebuilds the CSR before the next query.
+	// Lowering a weight discards the landmarks; raising or removing keeps them, as their distances stay lower bounds.
+
+	/**
+	 * @brief Sets the weight of every edge aFrom -> aTo.
+	 * @return False if a city or the edge does not exist.
+	 */
+	bool UpdateEdge(const std::string& aFrom, const std::string& aTo, float aWeight, std::vector<TEdgeChange>* aOutChanges = nullptr);
+
+	/**
+	 * @brief Removes every edge aFrom -> aTo (a failed link).
+	 * @return False if a city or the edge does not exist.
+	 */
+	bool RemoveEdge(const std::string& aFrom, const std::string& aTo, std::vector<TEdgeChange>* aOutChanges = nullptr);
+
+	/**
+	 * @brief Removes every edge into and out of a city (a failed node). The vertex keeps its id and name,
+	 * so ids stay dense and the name index stays valid; it is just no longer connected.
+	 * @return False if the city does not exist.
+	 */
+	bool RemoveVertex(const std::string& aName, std::vector<TEdgeChange>* aOutChanges = nullptr);
+
+	/**
+	 * @brief Changes with every added vertex and every edited edge, so derived data can tell it is out of date.
+	 */
+	uint64_t GetVersion() const { return version; }
+
+	// --- Freezing ---
+	/**
+	 * @brief Marks the graph as final: builds a minimal perfect hash over the names and the CSR adjacency.
+	 * Name lookups then take one hash probe plus one name compare, and the hash map is released.
+	 * The TEdge lists are released too, leaving 8 bytes per edge (target id + weight).
+	 * Adding a vertex or an edge afterwards thaws the graph automatically.
+	 * The vertices are renumbered by the order set with SetVertexOrder first.
+	 */
+	void Freeze();
+
+	bool IsFrozen() const { return isFrozen; }
+
+	/**
+	 * @brief Selects the vertex numbering of the next Freeze or LoadNameIndex (Input by default).
+	 * Renumbering changes ids and the version, so landmarks, hierarchies and saved indexes of the old ids no longer apply.
+	 * A frozen graph with another order is thawed, so the next Freeze renumbers it.
+	 */
+	void SetVertexOrder(EVertexOrder aOrder);
+	EVertexOrder GetVertexOrder() const { return vertexOrder; }
+
+	/**
+	 * @brief Position of a vertex in creation (file) order, whatever its id.
+	 */
+	int GetInputIndex(int aId) const { return inputIndexById[aId]; }
+
+	/**
+	 * @brief Writes the frozen name index to a binary file (e.g. next to the graph file).
+	 */
+	bool SaveNameIndex(const std::string& aFilename) const;
+
+	/**
+	 * @brief Memory-maps a name index written by SaveNameIndex and freezes the graph with it.
+	 * Fails if the file does not match the current vertex names (numbered by the vertex order) or is damaged
+	 * (slot ids that are out of range or repeated); the graph is then left unfrozen.
+	 */
+	bool LoadNameIndex(const std::string& aFilename);
 
 	// --- Algorithms ---
 	/**
-	 * @brief Resets all vertices to infinite distance and unvisited state.
+	 * @brief Resets the default query context: every vertex unreached (O(1), see TQueryContext).
 	 */
 	void ResetState();
 
 	/**
 	 * @brief Runs Dijkstra's algorithm from a start node.
 	 * Computes the shortest path to ALL other nodes.
+	 * Uses an indexed 4-ary heap with decrease-key, so each vertex is queued and popped at most once,
+	 * or a radix heap / bucket queue with near-constant-time operations when all weights are integers.
+	 * The result goes to the default context, read by PrintRoutingTable().
 	 */
 	bool RunDijkstra(const std::string& aStartCity);
 
 	/**
-	 * @brief Prints the routing table (Cost from Start -> All Cities).
+	 * @brief Same as above, but writes into aContext and does not modify the graph, so it may run on
+	 * several threads at once. The graph must have been frozen (or queried) since its last change.
+	 */
+	bool RunDijkstra(const std::string& aStartCity, TQueryContext& aContext) const;
+
+	/**
+	 * @brief Shortest route between two cities. The search stops as soon as the destination is settled,
+	 * so nearby destinations cost a fraction of a full RunDijkstra.
+	 * @return False if a city does not exist; aOutRoute.isReachable tells whether a route was found.
+	 */
+	bool ShortestPath(const std::string& aFrom, const std::string& aTo, TRoute& aOutRoute);
+
+	/**
+	 * @brief Same as above with a caller-owned context; const, so it can run on several threads at once.
+	 */
+	bool ShortestPath(const std::string& aFrom, const std::string& aTo, TRoute& aOutRoute, TQueryContext& aContext) const;
+
+	/**
+	 * @brief Same as above with vertex ids (e.g. resolved once with GetVertexId).
+	 * @return False if an id is out of range or the graph changed since it was frozen.
+	 */
+	bool ShortestPath(int aStartId, int aTargetId, TRoute& aOutRoute, TQueryContext& aContext) const;
+
+	/**
+	 * @brief Answers many (from, to) queries. With Dijkstra, queries that share a start city are answered
+	 * by one search that stops once all their destinations are settled.
+	 * @param aOutRoutes Receives one route per query, in query order (unknown cities give unreachable routes).
+	 * @param aThreadCount Worker threads, each with its own context (0 = one per hardware thread).
+	 * @return The number of queries with a route.
+	 */
+	int ShortestPaths(const std::vector<std::pair<std::string, std::string>>& aQueries, std::vector<TRoute>& aOutRoutes, int aThreadCount = 1);
+
+	/**
+	 * @brief Same as above with vertex ids (-1 for an unknown city) on a caller-owned pool; const, so the graph is
+	 * only read. Call PrepareForConcurrentQueries first.
+	 * @param aContexts One per pool thread.
+	 * @param aOutMicroseconds Optional; receives per query the time of the search that answered it.
+	 */
+	int ShortestPaths(const std::vector<std::pair<int, int>>& aQueries, std::vector<TRoute>& aOutRoutes, TThreadPool& aPool,
+		std::vector<TQueryContext>& aContexts, std::vector<float>* aOutMicroseconds = nullptr) const;
+
+	/**
+	 * @brief Parallel label-correcting shortest paths from a start node over a relaxed TMultiQueue.
+	 * Produces the same distances as RunDijkstra (into the default context), but spreads
+	 * the work over several threads; vertices may be relaxed more than once.
+	 * @param aThreadCount Worker threads (0 = one per hardware thread).
+	 * @param aOutStats Optional; receives the queue statistics of every worker thread.
+	 */
+	bool RunParallelDijkstra(const std::string& aStartCity, int aThreadCount = 0, TArrayWrapper<TMultiQueueStats>* aOutStats = nullptr);
+
+	// Graphs with at least this many vertices are worth a parallel RunDeltaStepping for a full routing table
+	static constexpr int kDeltaSteppingMinVertices = 50000;
+
+	/**
+	 * @brief Parallel delta-stepping shortest paths from a start node (into the default context, like RunDijkstra).
+	 * Tentative distances are kept in buckets of width aDelta. The current bucket is emptied in rounds that
+	 * relax the light edges (weight <= aDelta) of all its vertices in parallel, then their heavy edges are
+	 * relaxed once. Produces the same distances as RunDijkstra; parents may differ between equal-cost paths.
+	 * @param aDelta Bucket width (0 = GetDeltaSteppingDelta()). Small values approach Dijkstra, large ones Bellman-Ford.
+	 * @param aThreadCount Threads (0 = one per hardware thread).
+	 */
+	bool RunDeltaStepping(const std::string& aStartCity, float aDelta = 0.0f, int aThreadCount = 0);
+
+	/**
+	 * @brief The automatic bucket width: the largest edge weight divided by the average out-degree.
+	 */
+	float GetDeltaSteppingDelta() const;
+
+	/**
+	 * @brief Overrides the automatic queue selection (mainly for benchmarking).
+	 * Integer queues fall back to the heap if the graph has non-integer weights.
+	 */
+	void SetQueueStrategy(EDijkstraQueue aStrategy) { queueStrategy = aStrategy; }
+
+	/**
+	 * @brief Selects the search ShortestPath and ShortestPaths use (Dijkstra by default).
+	 */
+	void SetRouteAlgorithm(ERouteAlgorithm aAlgorithm) { routeAlgorithm = aAlgorithm; }
+	ERouteAlgorithm GetRouteAlgorithm() const { return routeAlgorithm; }
+
+	// --- ALT Preprocessing ---
+	static constexpr int kDefaultLandmarkCount = 8;
+
+	/**
+	 * @brief Picks aCount landmarks farthest-first and stores the distances from and to each of them.
+	 * Costs 2 * aCount full Dijkstra runs and 8 * aCount bytes per vertex. ShortestPath with
+	 * ERouteAlgorithm::Landmarks calls it on first use; a later change to the graph discards them.
+	 */
+	bool PrepareLandmarks(int aCount = kDefaultLandmarkCount);
+
+	int GetLandmarkCount() const { return landmarkCount; }
+
+	// --- Contraction Hierarchy ---
+	/**
+	 * @brief Uses aHierarchy for ERouteAlgorithm::ContractionHierarchy queries. It must have been built
+	 * from (or loaded for) this graph and outlive its use; changing the graph detaches it.
+	 */
+	void SetContractionHierarchy(const TContractionHierarchy* aHierarchy) { hierarchy = aHierarchy; }
+
+	// --- Routing Cache ---
+	/**
+	 * @brief Lets RunDijkstra(name) and RunDeltaStepping answer a start city from aCache when its table
+	 * for the current graph version is there, and store every table they compute. nullptr detaches it.
+	 */
+	void SetRoutingCache(TRoutingCache* aCache) { routingCache = aCache; }
+
+	/**
+	 * @brief Builds everything a query would otherwise build on first use (the CSR arrays, and the landmarks
+	 * for ERouteAlgorithm::Landmarks), so the const query methods can then share the graph between threads.
+	 */
+	void PrepareForConcurrentQueries();
+
+	/**
+	 * @brief The CSR arrays, built first if needed. Valid until the graph changes.
+	 */
+	TAdjacencyView GetAdjacency();
+
+	/**
+	 * @brief True if every edge weight added so far is a non-negative integer.
+	 */
+	bool HasIntegerWeights() const { return hasIntegerWeights; }
+
+	/**
+	 * @brief Prints the routing table (Cost from Start -> All Cities) of the last RunDijkstra.
 	 */
 	void PrintRoutingTable() const;
 
+	/**
+	 * @brief Prints the routing table held by a query context.
+	 */
+	void PrintRoutingTable(const TQueryContext& aContext) const;
+
+	/**
+	 * @brief Prints a route as "A -> B -> C" with its total cost.
+	 */
+	void PrintRoute(const TRoute& aRoute) const;
+
+	const std::string& GetVertexName(int aId) const { return vertexById[aId]->name; }
+
+	/**
+	 * @brief Id of a city, or -1 if there is none by that name.
+	 */
+	int GetVertexId(std::string_view aName) const {
+		TVertex* vertex = FindVertex(aName);
+		return (vertex != nullptr) ? vertex->id : -1;
+	}
+
 	// Helper to check if graph is empty
 	bool IsEmpty() const { return vertexCount == 0; }
 
+	int GetVertexCount() const { return vertexCount; }
+	int GetEdgeCount() const { return edgeCount; }
+
 	/**
 		 * @brief Prints a list of all available cities (Vertices).
 		 */
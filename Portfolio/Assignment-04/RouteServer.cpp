@@ -0,0 +1,662 @@
+#include "RouteServer.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <functional>
+#include <iostream>
+#include <limits>
+#include <string_view>
+#include <thread>
+
+#ifndef _WIN32
+#include <cerrno>
+#include <csignal>
+#include <fcntl.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <unistd.h>
+#endif
+
+// How long poll waits before checking for Stop
+static constexpr int kPollIntervalMs = 100;
+// A client that sends this much without a line break is dropped
+static constexpr std::size_t kMaxLineLength = std::size_t(64) << 10;
+static constexpr std::size_t kReadSize = std::size_t(64) << 10;
+// Requests claimed per pool step (TABLE requests are whole searches, so keep it small)
+static constexpr int kRequestChunkSize = 4;
+
+static int64_t NowMicroseconds()
+{
+	return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+TRouteServer::TRouteServer(TGraph& aGraph, int aThreadCount)
+	: graph(aGraph), pool(aThreadCount), contexts(static_cast<std::size_t>(pool.GetThreadCount())), isStopping(false),
+	firstConnection(0), requestCount(0), batchCount(0), connectionCount(0), largestBatch(0), startedAt(NowMicroseconds())
+{
+}
+
+bool TRouteServer::CollectRequests()
+{
+	batch.clear();
+	bool hasMore = false;
+
+	// Each connection takes at most an equal share of the batch, and the first connection visited moves on
+	// every round, so a client with a deep pipeline cannot starve the others
+	int openCount = 0;
+	for (const TConnection& connection : connections)
+	{
+		openCount += connection.isBroken ? 0 : 1;
+	}
+	int share = std::max(1, kMaxBatchSize / std::max(1, openCount));
+	for (std::size_t i = 0; i < connections.size(); i++)
+	{
+		std::size_t c = (firstConnection + i) % connections.size();
+		TConnection& connection = connections[c];
+		if (connection.isBroken)
+		{
+			continue;
+		}
+		int taken = 0;
+		std::size_t start = 0;
+		std::size_t end;
+		while ((end = connection.input.find('\n', start)) != std::string::npos)
+		{
+			if (static_cast<int>(batch.size()) == kMaxBatchSize || taken == share)
+			{
+				hasMore = true;
+				break;
+			}
+			std::string_view line(connection.input.data() + start, end - start);
+			start = end + 1;
+			if (!line.empty() && line.back() == '\r')
+			{
+				line.remove_suffix(1);
+			}
+			if (line.empty())
+			{
+				continue;
+			}
+
+			// Command word, then its argument
+			std::size_t space = line.find(' ');
+			std::string_view command = line.substr(0, space);
+			std::string_view argument = (space == std::string_view::npos) ? std::string_view() : line.substr(space + 1);
+			TRequest request;
+			request.connection = static_cast<int>(c);
+			request.receivedAt = NowMicroseconds();
+			request.kind = ERequestKind::Invalid;
+			if (command == "ROUTE")
+			{
+				std::size_t separator = argument.find(';');
+				if (separator != std::string_view::npos)
+				{
+					request.kind = ERequestKind::Route;
+					request.from = argument.substr(0, separator);
+					request.to = argument.substr(separator + 1);
+				}
+				else
+				{
+					request.reply = "ERROR expected ROUTE From;To\n";
+				}
+			}
+			else if (command == "TABLE")
+			{
+				request.kind = ERequestKind::Table;
+				request.from = argument;
+			}
+			else if (command == "STATS")
+			{
+				request.kind = ERequestKind::Stats;
+			}
+			else if (command == "SHUTDOWN")
+			{
+				request.kind = ERequestKind::Shutdown;
+			}
+			else
+			{
+				request.reply = "ERROR unknown command\n";
+			}
+			batch.push_back(std::move(request));
+			taken++;
+		}
+		connection.input.erase(0, start);
+	}
+	firstConnection = connections.empty() ? 0 : (firstConnection + 1) % connections.size();
+	return hasMore;
+}
+
+void TRouteServer::AnswerQuery(TRequest& aRequest, TQueryContext& aContext) const
+{
+	char cost[32];
+	int startId = graph.GetVertexId(aRequest.from);
+	int targetId = (aRequest.kind == ERequestKind::Route) ? graph.GetVertexId(aRequest.to) : startId;
+	if (startId < 0 || targetId < 0)
+	{
+		aRequest.reply = "ERROR unknown city\n";
+		return;
+	}
+
+	if (aRequest.kind == ERequestKind::Route)
+	{
+		TRoute route;
+		graph.ShortestPath(startId, targetId, route, aContext);
+		if (!route.isReachable)
+		{
+			aRequest.reply = "UNREACHABLE\n";
+			return;
+		}
+		std::snprintf(cost, sizeof(cost), "%g", route.cost);
+		aRequest.reply = "OK ";
+		aRequest.reply += cost;
+		aRequest.reply += ';';
+		for (std::size_t i = 0; i < route.vertices.size(); i++)
+		{
+			if (i > 0) aRequest.reply += " -> ";
+			aRequest.reply += graph.GetVertexName(route.vertices[i]);
+		}
+		aRequest.reply += '\n';
+		return;
+	}
+
+	// TABLE: one full search, then every city with its cost, in the order of the graph file
+	graph.RunDijkstra(aRequest.from, aContext);
+	int vertexCount = aContext.GetVertexCount();
+	std::vector<int> ids(static_cast<std::size_t>(vertexCount));
+	for (int id = 0; id < vertexCount; id++)
+	{
+		ids[static_cast<std::size_t>(graph.GetInputIndex(id))] = id;
+	}
+	aRequest.reply = "OK " + std::to_string(vertexCount) + "\n";
+	for (int i : ids)
+	{
+		float distance = aContext.GetDistance(i);
+		aRequest.reply += graph.GetVertexName(i);
+		if (distance == std::numeric_limits<float>::infinity())
+		{
+			aRequest.reply += ";unreachable\n";
+			continue;
+		}
+		std::snprintf(cost, sizeof(cost), ";%g\n", distance);
+		aRequest.reply += cost;
+	}
+}
+
+void TRouteServer::QueueReplies()
+{
+	int64_t now = NowMicroseconds();
+	for (TRequest& request : batch)
+	{
+		if (request.kind == ERequestKind::Stats)
+		{
+			TRouteServerStats stats = GetStats();
+			char line[256];
+			std::snprintf(line, sizeof(line), "OK requests=%lld batches=%lld connections=%lld open=%d largest_batch=%d seconds=%.3f rps=%.0f p50_us=%.1f p99_us=%.1f\n",
+				stats.requestCount, stats.batchCount, stats.connectionCount, stats.openConnections, stats.largestBatch,
+				stats.seconds, stats.requestsPerSecond, stats.p50Microseconds, stats.p99Microseconds);
+			request.reply = line;
+		}
+		else if (request.kind == ERequestKind::Shutdown)
+		{
+			request.reply = "OK\n";
+		}
+
+		TConnection& connection = connections[static_cast<std::size_t>(request.connection)];
+		if (!connection.isBroken)
+		{
+			connection.output += request.reply;
+		}
+
+		// Record the latency in the ring
+		float latency = static_cast<float>(now - request.receivedAt);
+		if (static_cast<int>(latencies.size()) < kLatencyWindow)
+		{
+			latencies.push_back(latency);
+		}
+		else
+		{
+			latencies[static_cast<std::size_t>(requestCount % kLatencyWindow)] = latency;
+		}
+		requestCount++;
+	}
+	batchCount++;
+	largestBatch = std::max(largestBatch, static_cast<int>(batch.size()));
+}
+
+TRouteServerStats TRouteServer::GetStats() const
+{
+	TRouteServerStats stats;
+	stats.requestCount = requestCount;
+	stats.batchCount = batchCount;
+	stats.connectionCount = connectionCount;
+	stats.openConnections = static_cast<int>(connections.size());
+	stats.largestBatch = largestBatch;
+	stats.seconds = static_cast<double>(NowMicroseconds() - startedAt) / 1e6;
+	stats.requestsPerSecond = (stats.seconds > 0.0) ? static_cast<double>(requestCount) / stats.seconds : 0.0;
+	std::vector<float> window = latencies;
+	stats.p50Microseconds = TRouteService::Percentile(window, 50.0);
+	stats.p99Microseconds = TRouteService::Percentile(window, 99.0);
+	return stats;
+}
+
+void TRouteServer::PrintStats(const TRouteServerStats& aStats, std::ostream& aOutput)
+{
+	aOutput << "Served " << aStats.requestCount << " requests in " << aStats.batchCount << " batches (largest "
+		<< aStats.largestBatch << ") over " << aStats.connectionCount << " connections in " << aStats.seconds << " s: "
+		<< static_cast<long long>(aStats.requestsPerSecond) << " requests/s, latency p50 " << aStats.p50Microseconds
+		<< " us, p99 " << aStats.p99Microseconds << " us." << std::endl;
+}
+
+#ifdef _WIN32
+
+void TRouteServer::Flush(TConnection&)
+{
+}
+
+bool TRouteServer::Run(const std::string&)
+{
+	std::cerr << "Error: The route server needs Unix domain sockets, which this build does not support." << std::endl;
+	return false;
+}
+
+bool RunRouteLoad(const std::string&, const std::vector<std::string>&, int, int, TRouteServiceStats&)
+{
+	std::cerr << "Error: The route server needs Unix domain sockets, which this build does not support." << std::endl;
+	return false;
+}
+
+#else
+
+/**
+ * @brief Fills aOutAddress for aSocketPath; false (with a message) if the path does not fit.
+ */
+static bool MakeAddress(const std::string& aSocketPath, sockaddr_un& aOutAddress)
+{
+	std::memset(&aOutAddress, 0, sizeof(aOutAddress));
+	if (aSocketPath.empty() || aSocketPath.size() >= sizeof(aOutAddress.sun_path))
+	{
+		std::cerr << "Error: Socket path '" << aSocketPath << "' is empty or too long." << std::endl;
+		return false;
+	}
+	aOutAddress.sun_family = AF_UNIX;
+	std::memcpy(aOutAddress.sun_path, aSocketPath.c_str(), aSocketPath.size() + 1);
+	return true;
+}
+
+static bool SetNonBlocking(int aSocket)
+{
+	int flags = fcntl(aSocket, F_GETFL, 0);
+	return flags >= 0 && fcntl(aSocket, F_SETFL, flags | O_NONBLOCK) == 0;
+}
+
+/**
+ * @brief Reads everything the socket has without blocking.
+ */
+static void Receive(int aSocket, std::string& aInput, bool& aOutIsReadClosed, bool& aOutIsBroken)
+{
+	char buffer[4096];
+	std::size_t received = 0;
+	while (received < kReadSize)
+	{
+		ssize_t count = read(aSocket, buffer, sizeof(buffer));
+		if (count > 0)
+		{
+			aInput.append(buffer, static_cast<std::size_t>(count));
+			received += static_cast<std::size_t>(count);
+			continue;
+		}
+		if (count == 0)
+		{
+			aOutIsReadClosed = true;
+		}
+		else if (errno == EINTR)
+		{
+			continue;
+		}
+		else if (errno != EAGAIN && errno != EWOULDBLOCK)
+		{
+			aOutIsBroken = true;
+		}
+		break;
+	}
+	if (aInput.size() > kMaxLineLength && aInput.find('\n', aInput.size() - kMaxLineLength) == std::string::npos)
+	{
+		aOutIsBroken = true;
+	}
+}
+
+void TRouteServer::Flush(TConnection& aConnection)
+{
+	std::size_t sent = 0;
+	while (sent < aConnection.output.size())
+	{
+		ssize_t count = write(aConnection.socket, aConnection.output.data() + sent, aConnection.output.size() - sent);
+		if (count > 0)
+		{
+			sent += static_cast<std::size_t>(count);
+			continue;
+		}
+		if (count < 0 && errno == EINTR)
+		{
+			continue;
+		}
+		if (count < 0 && errno != EAGAIN && errno != EWOULDBLOCK)
+		{
+			aConnection.isBroken = true;
+		}
+		break;
+	}
+	aConnection.output.erase(0, sent);
+}
+
+bool TRouteServer::Run(const std::string& aSocketPath)
+{
+	sockaddr_un address;
+	if (!MakeAddress(aSocketPath, address))
+	{
+		return false;
+	}
+
+	// Replace a socket left behind by a server that did not shut down, but never any other kind of file
+	struct stat status;
+	if (stat(aSocketPath.c_str(), &status) == 0 && S_ISSOCK(status.st_mode))
+	{
+		unlink(aSocketPath.c_str());
+	}
+	int listener = socket(AF_UNIX, SOCK_STREAM, 0);
+	if (listener < 0 || bind(listener, reinterpret_cast<const sockaddr*>(&address), sizeof(address)) != 0
+		|| listen(listener, SOMAXCONN) != 0 || !SetNonBlocking(listener))
+	{
+		std::cerr << "Error: Cannot listen on '" << aSocketPath << "': " << std::strerror(errno) << std::endl;
+		if (listener >= 0) close(listener);
+		return false;
+	}
+	// A client that hangs up before its replies are written must not end the server
+	std::signal(SIGPIPE, SIG_IGN);
+
+	// Everything lazily built by a query is built here, so the workers only read the graph
+	graph.PrepareForConcurrentQueries();
+
+	const TThreadPool::FParallelBody answer = [this](int aIndex, int aThreadIndex)
+	{
+		TRequest& request = batch[static_cast<std::size_t>(aIndex)];
+		if (request.kind == ERequestKind::Route || request.kind == ERequestKind::Table)
+		{
+			AnswerQuery(request, contexts[static_cast<std::size_t>(aThreadIndex)]);
+		}
+	};
+
+	startedAt = NowMicroseconds();
+	std::vector<pollfd> polls;
+	bool hasPendingLines = false;
+	bool isShuttingDown = false;
+	while (!isStopping)
+	{
+		// 1. Wait for new connections, requests or room to write
+		polls.clear();
+		polls.push_back({ listener, POLLIN, 0 });
+		for (const TConnection& connection : connections)
+		{
+			short events = static_cast<short>((connection.isReadClosed ? 0 : POLLIN) | (connection.output.empty() ? 0 : POLLOUT));
+			polls.push_back({ connection.socket, events, 0 });
+		}
+		if (poll(polls.data(), static_cast<nfds_t>(polls.size()), hasPendingLines ? 0 : kPollIntervalMs) < 0)
+		{
+			if (errno == EINTR) continue;
+			std::cerr << "Error: poll failed: " << std::strerror(errno) << std::endl;
+			break;
+		}
+
+		// 2. Read and write (the connections accepted below are polled from the next round on)
+		for (std::size_t i = 1; i < polls.size(); i++)
+		{
+			TConnection& connection = connections[i - 1];
+			if ((polls[i].revents & (POLLIN | POLLHUP | POLLERR)) != 0 && !connection.isReadClosed)
+			{
+				Receive(connection.socket, connection.input, connection.isReadClosed, connection.isBroken);
+			}
+			if ((polls[i].revents & POLLOUT) != 0)
+			{
+				Flush(connection);
+			}
+		}
+		if (!isShuttingDown && (polls[0].revents & POLLIN) != 0)
+		{
+			int client;
+			while ((client = accept(listener, nullptr, nullptr)) >= 0)
+			{
+				SetNonBlocking(client);
+				connections.emplace_back();
+				connections.back().socket = client;
+				connectionCount++;
+			}
+		}
+
+		// 3. Answer every complete line as one batch, and reply in order
+		hasPendingLines = CollectRequests();
+		if (!batch.empty())
+		{
+			pool.ParallelFor(static_cast<int>(batch.size()), answer, kRequestChunkSize);
+			QueueReplies();
+			for (const TRequest& request : batch)
+			{
+				isShuttingDown = isShuttingDown || request.kind == ERequestKind::Shutdown;
+			}
+			for (TConnection& connection : connections)
+			{
+				if (!connection.output.empty() && !connection.isBroken) Flush(connection);
+			}
+		}
+
+		// 4. Close the connections that are done: broken, or hung up with every reply sent
+		bool hasOutput = false;
+		std::size_t kept = 0;
+		for (std::size_t i = 0; i < connections.size(); i++)
+		{
+			TConnection& connection = connections[i];
+			bool isDone = connection.isBroken
+				|| (connection.isReadClosed && connection.output.empty() && connection.input.find('\n') == std::string::npos);
+			if (isDone)
+			{
+				close(connection.socket);
+				continue;
+			}
+			hasOutput = hasOutput || !connection.output.empty();
+			if (kept != i) connections[kept] = std::move(connection);
+			kept++;
+		}
+		connections.resize(kept);
+		if (isShuttingDown && !hasOutput)
+		{
+			break;
+		}
+	}
+
+	for (TConnection& connection : connections)
+	{
+		close(connection.socket);
+	}
+	connections.clear();
+	close(listener);
+	unlink(aSocketPath.c_str());
+	return true;
+}
+
+// --- Load generator ---
+
+struct TLoadResult {
+	std::vector<float> latencies;
+	long long reachableCount = 0;
+	long long unknownCount = 0;
+	bool isFailed = false;
+};
+
+/**
+ * @brief Blocking line reader over a socket.
+ */
+class TLineReader {
+private:
+	int socket;
+	std::string buffer;
+	std::size_t start = 0;
+
+public:
+	explicit TLineReader(int aSocket) : socket(aSocket) {}
+
+	bool Next(std::string& aOutLine)
+	{
+		std::size_t end;
+		while ((end = buffer.find('\n', start)) == std::string::npos)
+		{
+			buffer.erase(0, start);
+			start = 0;
+			char chunk[4096];
+			ssize_t count = read(socket, chunk, sizeof(chunk));
+			if (count < 0 && errno == EINTR) continue;
+			if (count <= 0) return false;
+			buffer.append(chunk, static_cast<std::size_t>(count));
+		}
+		aOutLine.assign(buffer, start, end - start);
+		start = end + 1;
+		return true;
+	}
+};
+
+static bool WriteAll(int aSocket, const std::string& aData)
+{
+	std::size_t sent = 0;
+	while (sent < aData.size())
+	{
+		ssize_t count = write(aSocket, aData.data() + sent, aData.size() - sent);
+		if (count < 0 && errno == EINTR) continue;
+		if (count <= 0) return false;
+		sent += static_cast<std::size_t>(count);
+	}
+	return true;
+}
+
+/**
+ * @brief One client connection: sends the queries aIndex, aIndex + aStep, ... keeping aDepth in flight.
+ */
+static void RunLoadConnection(const sockaddr_un& aAddress, const std::vector<std::string>& aQueries, std::size_t aIndex,
+	std::size_t aStep, std::size_t aDepth, TLoadResult& aOutResult)
+{
+	int client = socket(AF_UNIX, SOCK_STREAM, 0);
+	if (client < 0 || connect(client, reinterpret_cast<const sockaddr*>(&aAddress), sizeof(aAddress)) != 0)
+	{
+		aOutResult.isFailed = true;
+		if (client >= 0) close(client);
+		return;
+	}
+
+	struct TInFlight {
+		int64_t sentAt;
+		bool isTable;
+	};
+	std::vector<TInFlight> inFlight; // FIFO: replies come back in request order
+	std::size_t oldest = 0;
+	TLineReader reader(client);
+	std::string requests;
+	std::string line;
+	std::size_t next = aIndex;
+	while (next < aQueries.size() || oldest < inFlight.size())
+	{
+		// Top up the pipeline
+		requests.clear();
+		while (inFlight.size() - oldest < aDepth && next < aQueries.size())
+		{
+			const std::string& query = aQueries[next];
+			bool isTable = query.find(';') == std::string::npos;
+			requests += isTable ? "TABLE " : "ROUTE ";
+			requests += query;
+			requests += '\n';
+			inFlight.push_back({ NowMicroseconds(), isTable });
+			next += aStep;
+		}
+		if (!requests.empty() && !WriteAll(client, requests))
+		{
+			aOutResult.isFailed = true;
+			break;
+		}
+
+		// Take one reply (a table is a header line and one line per city)
+		if (!reader.Next(line))
+		{
+			aOutResult.isFailed = true;
+			break;
+		}
+		const TInFlight& request = inFlight[oldest++];
+		bool isOk = line.compare(0, 3, "OK ") == 0;
+		if (request.isTable && isOk)
+		{
+			long long lineCount = std::atoll(line.c_str() + 3);
+			std::string row;
+			for (long long i = 0; i < lineCount && !aOutResult.isFailed; i++)
+			{
+				aOutResult.isFailed = !reader.Next(row);
+			}
+		}
+		aOutResult.latencies.push_back(static_cast<float>(NowMicroseconds() - request.sentAt));
+		if (isOk) aOutResult.reachableCount++;
+		if (line.compare(0, 5, "ERROR") == 0) aOutResult.unknownCount++;
+		if (oldest == inFlight.size())
+		{
+			inFlight.clear();
+			oldest = 0;
+		}
+	}
+	close(client);
+}
+
+bool RunRouteLoad(const std::string& aSocketPath, const std::vector<std::string>& aQueries, int aConnectionCount,
+	int aPipelineDepth, TRouteServiceStats& aOutStats)
+{
+	aOutStats = TRouteServiceStats();
+	sockaddr_un address;
+	if (!MakeAddress(aSocketPath, address))
+	{
+		return false;
+	}
+	std::size_t connectionCount = static_cast<std::size_t>(std::max(aConnectionCount, 1));
+	std::size_t depth = static_cast<std::size_t>(std::max(aPipelineDepth, 1));
+	std::signal(SIGPIPE, SIG_IGN);
+
+	// A thread per connection, so they really are concurrent clients
+	std::vector<TLoadResult> results(connectionCount);
+	std::vector<std::thread> clients;
+	int64_t start = NowMicroseconds();
+	for (std::size_t i = 0; i < connectionCount; i++)
+	{
+		clients.emplace_back(RunLoadConnection, std::cref(address), std::cref(aQueries), i, connectionCount, depth, std::ref(results[i]));
+	}
+	for (std::thread& client : clients)
+	{
+		client.join();
+	}
+
+	std::vector<float> latencies;
+	bool isFailed = false;
+	for (TLoadResult& result : results)
+	{
+		latencies.insert(latencies.end(), result.latencies.begin(), result.latencies.end());
+		aOutStats.reachableCount += result.reachableCount;
+		aOutStats.unknownCount += result.unknownCount;
+		isFailed = isFailed || result.isFailed;
+	}
+	aOutStats.queryCount = static_cast<long long>(latencies.size());
+	aOutStats.seconds = static_cast<double>(NowMicroseconds() - start) / 1e6;
+	aOutStats.queriesPerSecond = (aOutStats.seconds > 0.0) ? static_cast<double>(aOutStats.queryCount) / aOutStats.seconds : 0.0;
+	aOutStats.p50Microseconds = TRouteService::Percentile(latencies, 50.0);
+	aOutStats.p99Microseconds = TRouteService::Percentile(latencies, 99.0);
+	if (isFailed)
+	{
+		std::cerr << "Error: A connection to '" << aSocketPath << "' failed." << std::endl;
+	}
+	return !isFailed;
+}
+
+#endif // _WIN32
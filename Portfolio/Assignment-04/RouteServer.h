@@ -0,0 +1,136 @@
+#pragma once
+#ifndef ROUTE_SERVER_H
+#define ROUTE_SERVER_H
+
+#include <atomic>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "ThreadPool.h"
+#include "RouteService.h"
+#include "Graph.h"
+
+/**
+ * @brief Counters of a running TRouteServer (as sent back for the STATS command).
+ */
+struct TRouteServerStats {
+	long long requestCount = 0;
+	long long batchCount = 0;
+	long long connectionCount = 0; // Accepted so far
+	int openConnections = 0;
+	int largestBatch = 0;
+	double seconds = 0.0;          // Since the server started listening
+	double requestsPerSecond = 0.0;
+	double p50Microseconds = 0.0;  // Over the last kLatencyWindow requests, from receipt to queued reply
+	double p99Microseconds = 0.0;
+};
+
+/**
+ * @brief Serves route queries on one resident graph to local clients over a Unix domain socket.
+ * The protocol is one request per line, answered in order on the same connection:
+ *   ROUTE From;To  ->  OK Cost;A -> B -> C | UNREACHABLE | ERROR unknown city
+ *   TABLE From     ->  OK N, then N lines "City;Cost" (cost "unreachable" if none) | ERROR unknown city
+ *   STATS          ->  OK requests=... batches=... (see TRouteServerStats)
+ *   SHUTDOWN       ->  OK, then the server stops once the replies are sent
+ * One thread multiplexes every connection with poll(); all complete lines that arrive together
+ * (across connections) form one batch, which the worker pool answers with a query context per thread.
+ * Requests that arrive while a batch runs wait in the socket buffers and make up the next one.
+ */
+class TRouteServer {
+public:
+	static constexpr int kMaxBatchSize = 4096;
+	static constexpr int kLatencyWindow = 1 << 16;
+
+private:
+	enum class ERequestKind { Route, Table, Stats, Shutdown, Invalid };
+
+	struct TRequest {
+		int connection;
+		ERequestKind kind;
+		std::string from;
+		std::string to;
+		int64_t receivedAt; // Steady clock, microseconds
+		std::string reply;
+	};
+
+	struct TConnection {
+		int socket = -1;
+		std::string input;
+		std::string output;
+		bool isReadClosed = false; // The client sent everything it will send
+		bool isBroken = false;     // Reading or writing failed: dropped without replies
+	};
+
+	TGraph& graph;
+	TThreadPool pool;
+	std::vector<TQueryContext> contexts; // One per pool thread
+	std::atomic<bool> isStopping;
+	std::vector<TConnection> connections;
+	std::size_t firstConnection; // Where CollectRequests starts, rotated every round
+	std::vector<TRequest> batch;
+	std::vector<float> latencies; // Ring of the last kLatencyWindow request latencies (microseconds)
+	long long requestCount;
+	long long batchCount;
+	long long connectionCount;
+	int largestBatch;
+	int64_t startedAt;
+
+	/**
+	 * @brief Moves complete lines of the connections into the batch, up to kMaxBatchSize requests
+	 * and an equal share of them per connection.
+	 * @return True if lines were left behind for the next round.
+	 */
+	bool CollectRequests();
+
+	/**
+	 * @brief Answers one ROUTE or TABLE request (run by the pool).
+	 */
+	void AnswerQuery(TRequest& aRequest, TQueryContext& aContext) const;
+
+	/**
+	 * @brief Queues every reply of the batch on its connection in request order and records the latencies.
+	 */
+	void QueueReplies();
+
+	/**
+	 * @brief Writes as much pending output as the socket takes without blocking.
+	 */
+	static void Flush(TConnection& aConnection);
+
+public:
+	/**
+	 * @param aThreadCount Pool threads (0 = one per hardware thread).
+	 */
+	explicit TRouteServer(TGraph& aGraph, int aThreadCount = 0);
+
+	TRouteServer(const TRouteServer&) = delete;
+	TRouteServer& operator=(const TRouteServer&) = delete;
+
+	/**
+	 * @brief Listens on aSocketPath (replacing a stale socket file) and serves until SHUTDOWN or Stop.
+	 * @return False if the socket cannot be created.
+	 */
+	bool Run(const std::string& aSocketPath);
+
+	/**
+	 * @brief Makes Run return within a poll interval; safe to call from any thread.
+	 */
+	void Stop() { isStopping = true; }
+
+	int GetThreadCount() const { return pool.GetThreadCount(); }
+
+	TRouteServerStats GetStats() const;
+
+	static void PrintStats(const TRouteServerStats& aStats, std::ostream& aOutput);
+};
+
+/**
+ * @brief Load generator for TRouteServer: replays "From;To" lines (ROUTE) and lone "From" lines (TABLE)
+ * over aConnectionCount connections at once, each keeping up to aPipelineDepth requests in flight.
+ * The queries are dealt out round robin. Latency is measured at the client, from sending to the full reply.
+ * @return False if a connection fails.
+ */
+bool RunRouteLoad(const std::string& aSocketPath, const std::vector<std::string>& aQueries, int aConnectionCount,
+	int aPipelineDepth, TRouteServiceStats& aOutStats);
+
+#endif // ROUTE_SERVER_H
@@ -0,0 +1,142 @@
+#include "RouteService.h"
+#include <algorithm>
+#include <chrono>
+
+// Names resolved per pool step; a lookup is short, so single items would mostly measure the counter
+static constexpr int kLookupChunkSize = 16;
+
+TRouteService::TRouteService(TGraph& aGraph, int aThreadCount, int aBatchSize)
+	: graph(aGraph), pool(aThreadCount), contexts(static_cast<std::size_t>(pool.GetThreadCount())),
+	batchSize(aBatchSize > 0 ? aBatchSize : kDefaultBatchSize)
+{
+}
+
+TRouteServiceStats TRouteService::Run(const FQuerySource& aSource, const FRouteSink& aSink)
+{
+	// Everything lazily built by a query is built here, so the workers only read the graph
+	graph.PrepareForConcurrentQueries();
+
+	TRouteServiceStats stats;
+	std::vector<std::pair<std::string, std::string>> queries(static_cast<std::size_t>(batchSize));
+	std::vector<std::pair<int, int>> ids;
+	std::vector<TRoute> routes;
+	std::vector<float> batchLatencies;
+	std::vector<float> latencies; // Microseconds, every query of the run
+
+	const TGraph& sharedGraph = graph;
+	const TThreadPool::FParallelBody lookUp = [&](int aIndex, int)
+	{
+		std::size_t i = static_cast<std::size_t>(aIndex);
+		ids[i] = { sharedGraph.GetVertexId(queries[i].first), sharedGraph.GetVertexId(queries[i].second) };
+	};
+
+	auto runStart = std::chrono::steady_clock::now();
+	while (true)
+	{
+		// 1. Read a batch
+		int count = 0;
+		while (count < batchSize && aSource(queries[static_cast<std::size_t>(count)]))
+		{
+			count++;
+		}
+		if (count == 0)
+		{
+			break;
+		}
+
+		// 2. Resolve the names and solve the batch on all threads (queries sharing a start city share a search)
+		ids.resize(static_cast<std::size_t>(count));
+		pool.ParallelFor(count, lookUp, kLookupChunkSize);
+		sharedGraph.ShortestPaths(ids, routes, pool, contexts, &batchLatencies);
+
+		// 3. Hand the routes on in input order
+		for (std::size_t i = 0; i < static_cast<std::size_t>(count); i++)
+		{
+			bool isKnown = ids[i].first >= 0 && ids[i].second >= 0;
+			aSink(queries[i], isKnown, routes[i]);
+			if (!isKnown) stats.unknownCount++;
+			if (routes[i].isReachable) stats.reachableCount++;
+		}
+		latencies.insert(latencies.end(), batchLatencies.begin(), batchLatencies.begin() + count);
+		stats.queryCount += count;
+
+		if (count < batchSize)
+		{
+			break;
+		}
+	}
+
+	stats.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - runStart).count();
+	stats.queriesPerSecond = (stats.seconds > 0.0) ? static_cast<double>(stats.queryCount) / stats.seconds : 0.0;
+	stats.p50Microseconds = Percentile(latencies, 50.0);
+	stats.p99Microseconds = Percentile(latencies, 99.0);
+	return stats;
+}
+
+TRouteServiceStats TRouteService::Run(std::istream& aInput, std::ostream& aOutput)
+{
+	std::string line;
+	auto readQuery = [&](std::pair<std::string, std::string>& aOutQuery)
+	{
+		while (std::getline(aInput, line))
+		{
+			if (!line.empty() && line.back() == '\r')
+			{
+				line.pop_back();
+			}
+			if (line.empty() || line[0] == '#')
+			{
+				continue;
+			}
+			// A line without a separator names no destination, so it comes out as unknown
+			std::size_t separator = line.find(';');
+			aOutQuery.first = line.substr(0, separator);
+			aOutQuery.second = (separator == std::string::npos) ? std::string() : line.substr(separator + 1);
+			return true;
+		}
+		return false;
+	};
+	auto writeRoute = [&](const std::pair<std::string, std::string>& aQuery, bool aIsKnown, const TRoute& aRoute)
+	{
+		aOutput << aQuery.first << ';' << aQuery.second << ';';
+		if (!aIsKnown)
+		{
+			aOutput << "unknown;\n";
+			return;
+		}
+		if (!aRoute.isReachable)
+		{
+			aOutput << "unreachable;\n";
+			return;
+		}
+		aOutput << aRoute.cost << ';';
+		for (std::size_t i = 0; i < aRoute.vertices.size(); i++)
+		{
+			aOutput << (i > 0 ? " -> " : "") << graph.GetVertexName(aRoute.vertices[i]);
+		}
+		aOutput << '\n';
+	};
+
+	TRouteServiceStats stats = Run(readQuery, writeRoute);
+	aOutput.flush();
+	return stats;
+}
+
+double TRouteService::Percentile(std::vector<float>& aValues, double aPercent)
+{
+	if (aValues.empty())
+	{
+		return 0.0;
+	}
+	std::size_t rank = static_cast<std::size_t>(aPercent / 100.0 * static_cast<double>(aValues.size() - 1) + 0.5);
+	std::nth_element(aValues.begin(), aValues.begin() + static_cast<std::ptrdiff_t>(rank), aValues.end());
+	return aValues[rank];
+}
+
+void TRouteService::PrintStats(const TRouteServiceStats& aStats, std::ostream& aOutput)
+{
+	aOutput << "Answered " << aStats.queryCount << " queries (" << aStats.reachableCount << " reachable, "
+		<< aStats.unknownCount << " unknown) in " << aStats.seconds << " s: "
+		<< static_cast<long long>(aStats.queriesPerSecond) << " queries/s, latency p50 "
+		<< aStats.p50Microseconds << " us, p99 " << aStats.p99Microseconds << " us." << std::endl;
+}
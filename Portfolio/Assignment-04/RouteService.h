@@ -0,0 +1,79 @@
+#pragma once
+#ifndef ROUTE_SERVICE_H
+#define ROUTE_SERVICE_H
+
+#include <functional>
+#include <iostream>
+#include <string>
+#include <utility>
+#include <vector>
+#include "ThreadPool.h"
+#include "Graph.h"
+
+/**
+ * @brief Totals of one TRouteService run. A query's latency is the time of the search that answered it
+ * (shared by the queries of a batch that start in the same city when the algorithm is Dijkstra).
+ */
+struct TRouteServiceStats {
+	long long queryCount = 0;
+	long long reachableCount = 0;
+	long long unknownCount = 0; // Queries naming a city the graph does not have
+	double seconds = 0.0;       // Wall time, reading and writing included
+	double queriesPerSecond = 0.0;
+	double p50Microseconds = 0.0;
+	double p99Microseconds = 0.0;
+};
+
+/**
+ * @brief Answers a stream of (from, to) route queries on a thread pool over one shared, read-only graph.
+ * Queries are read in batches; each batch is answered by TGraph::ShortestPaths on the pool (every thread
+ * with its own TQueryContext, so the graph is never written) and its routes are handed on in input order
+ * before the next batch is read. Memory stays bounded by the batch size however long the stream is.
+ */
+class TRouteService {
+public:
+	static constexpr int kDefaultBatchSize = 4096;
+
+	// Fills aOutQuery with the next query; false at the end of the stream
+	typedef std::function<bool(std::pair<std::string, std::string>& aOutQuery)> FQuerySource;
+	// Receives every query with its route, in input order; aIsKnown is false if a city does not exist
+	typedef std::function<void(const std::pair<std::string, std::string>& aQuery, bool aIsKnown, const TRoute& aRoute)> FRouteSink;
+
+private:
+	TGraph& graph;
+	TThreadPool pool;
+	std::vector<TQueryContext> contexts; // One per pool thread
+	int batchSize;
+
+public:
+	/**
+	 * @param aThreadCount Threads (0 = one per hardware thread).
+	 */
+	explicit TRouteService(TGraph& aGraph, int aThreadCount = 0, int aBatchSize = kDefaultBatchSize);
+
+	TRouteService(const TRouteService&) = delete;
+	TRouteService& operator=(const TRouteService&) = delete;
+
+	int GetThreadCount() const { return pool.GetThreadCount(); }
+
+	/**
+	 * @brief Answers every query of aSource with the graph's current route algorithm.
+	 */
+	TRouteServiceStats Run(const FQuerySource& aSource, const FRouteSink& aSink);
+
+	/**
+	 * @brief Reads "From;To" lines (the separator of the graph files) and writes one "From;To;Cost;A -> B -> C" line
+	 * per query. Unreachable destinations get the cost "unreachable", unknown cities "unknown". Blank lines and
+	 * lines starting with '#' are skipped.
+	 */
+	TRouteServiceStats Run(std::istream& aInput, std::ostream& aOutput);
+
+	static void PrintStats(const TRouteServiceStats& aStats, std::ostream& aOutput);
+
+	/**
+	 * @brief The value below which aPercent percent of aValues lie (nearest rank; reorders aValues, 0 if empty).
+	 */
+	static double Percentile(std::vector<float>& aValues, double aPercent);
+};
+
+#endif // ROUTE_SERVICE_H
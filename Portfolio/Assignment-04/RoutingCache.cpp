@@ -0,0 +1,194 @@
+#include "RoutingCache.h"
+#include <limits>
+
+TRoutingCache::TRoutingCache(std::size_t aMemoryBudget)
+	: memoryBudget(aMemoryBudget), entryCount(0), newest(-1), oldest(-1), hits(0), misses(0), evictions(0)
+{
+}
+
+int TRoutingCache::GetCapacity(int aVertexCount) const
+{
+	std::size_t tableBytes = static_cast<std::size_t>(aVertexCount > 0 ? aVertexCount : 1) * (sizeof(float) + sizeof(int));
+	std::size_t capacity = memoryBudget / tableBytes;
+	return (capacity > static_cast<std::size_t>(std::numeric_limits<int>::max())) ? std::numeric_limits<int>::max() : static_cast<int>(capacity);
+}
+
+void TRoutingCache::Unlink(int aIndex)
+{
+	TEntry& entry = entries[aIndex];
+	if (entry.newer >= 0)
+	{
+		entries[entry.newer].older = entry.older;
+	}
+	else
+	{
+		newest = entry.older;
+	}
+	if (entry.older >= 0)
+	{
+		entries[entry.older].newer = entry.newer;
+	}
+	else
+	{
+		oldest = entry.newer;
+	}
+	entry.newer = -1;
+	entry.older = -1;
+}
+
+void TRoutingCache::PushNewest(int aIndex)
+{
+	TEntry& entry = entries[aIndex];
+	entry.newer = -1;
+	entry.older = newest;
+	if (newest >= 0)
+	{
+		entries[newest].newer = aIndex;
+	}
+	else
+	{
+		oldest = aIndex;
+	}
+	newest = aIndex;
+}
+
+void TRoutingCache::Evict(int aIndex)
+{
+	Unlink(aIndex);
+	TEntry& entry = entries[aIndex];
+	entryOfSource[entry.source] = -1;
+	entry.source = -1;
+	// Give the memory back, so the budget holds even while the graph grows
+	entry.distances.Clear();
+	entry.distances.ShrinkToFit();
+	entry.parents.Clear();
+	entry.parents.ShrinkToFit();
+	freeEntries.Add(aIndex);
+	entryCount--;
+	evictions++;
+}
+
+int TRoutingCache::Lookup(int aSourceId, uint64_t aVersion)
+{
+	int index = (aSourceId >= 0 && aSourceId < entryOfSource.GetCount()) ? entryOfSource[aSourceId] : -1;
+	if (index < 0 || entries[index].version != aVersion)
+	{
+		misses++;
+		return -1;
+	}
+	hits++;
+	Unlink(index);
+	PushNewest(index);
+	return index;
+}
+
+bool TRoutingCache::Load(int aSourceId, uint64_t aVersion, TQueryContext& aOutContext)
+{
+	int index = Lookup(aSourceId, aVersion);
+	if (index < 0)
+	{
+		return false;
+	}
+
+	const TEntry& entry = entries[index];
+	int vertexCount = entry.distances.GetCount();
+	aOutContext.Begin(vertexCount, aSourceId);
+	for (int i = 0; i < vertexCount; i++)
+	{
+		if (entry.distances[i] != std::numeric_limits<float>::infinity())
+		{
+			aOutContext.SetLabel(i, entry.distances[i], entry.parents[i]);
+			aOutContext.Settle(i);
+		}
+	}
+	return true;
+}
+
+bool TRoutingCache::Find(int aSourceId, uint64_t aVersion, const float*& aOutDistances, const int*& aOutParents)
+{
+	int index = Lookup(aSourceId, aVersion);
+	if (index < 0)
+	{
+		return false;
+	}
+	aOutDistances = entries[index].distances.GetData();
+	aOutParents = entries[index].parents.GetData();
+	return true;
+}
+
+void TRoutingCache::Store(const TQueryContext& aContext, uint64_t aVersion)
+{
+	int source = aContext.GetSource();
+	int vertexCount = aContext.GetVertexCount();
+	int capacity = GetCapacity(vertexCount);
+	if (source < 0)
+	{
+		return;
+	}
+	if (capacity == 0)
+	{
+		// Not even one table of this size fits any more
+		while (oldest >= 0)
+		{
+			Evict(oldest);
+		}
+		return;
+	}
+	if (entryOfSource.GetCount() < vertexCount)
+	{
+		entryOfSource.Resize(vertexCount, -1);
+	}
+
+	// 1. Reuse the source's own (stale) entry, or take a new one. Evict down to the capacity first:
+	// it drops when the graph grows, so more than one table may have to go.
+	int index = entryOfSource[source];
+	if (index >= 0)
+	{
+		Unlink(index);
+	}
+	int keep = (index >= 0) ? capacity : capacity - 1;
+	while (entryCount > keep)
+	{
+		Evict(oldest);
+	}
+	if (index < 0)
+	{
+		if (!freeEntries.IsEmpty())
+		{
+			index = freeEntries.RemoveLast();
+		}
+		else
+		{
+			index = entries.GetCount();
+			entries.Emplace();
+		}
+		entries[index].source = source;
+		entryOfSource[source] = index;
+		entryCount++;
+	}
+	PushNewest(index);
+
+	// 2. Copy the table out of the context
+	TEntry& entry = entries[index];
+	entry.version = aVersion;
+	entry.distances.Resize(vertexCount);
+	entry.parents.Resize(vertexCount);
+	for (int i = 0; i < vertexCount; i++)
+	{
+		entry.distances[i] = aContext.GetDistance(i);
+		entry.parents[i] = aContext.GetParent(i);
+	}
+}
+
+void TRoutingCache::Clear()
+{
+	entries.Clear();
+	freeEntries.Clear();
+	for (int i = 0; i < entryOfSource.GetCount(); i++)
+	{
+		entryOfSource[i] = -1;
+	}
+	entryCount = 0;
+	newest = -1;
+	oldest = -1;
+}
@@ -0,0 +1,93 @@
+#pragma once
+#ifndef ROUTING_CACHE_H
+#define ROUTING_CACHE_H
+
+#include <cstddef>
+#include <cstdint>
+#include "ArrayWrapper.hpp"
+#include "Graph.h"
+
+/**
+ * @brief Least-recently-used cache of full routing tables (distance and parent of every vertex), one per source.
+ * Entries are keyed by (source id, graph version): a table stored before the graph was edited no longer matches
+ * and counts as a miss. The number of tables follows from a memory budget, as each costs 8 bytes per vertex.
+ * Recency is an intrusive doubly linked list over the entry indices, so lookups, stores and evictions are O(1)
+ * apart from copying the tables themselves.
+ */
+class TRoutingCache {
+public:
+	static constexpr std::size_t kDefaultMemoryBudget = std::size_t(64) << 20;
+
+private:
+	struct TEntry {
+		int source = -1;
+		uint64_t version = 0;
+		int newer = -1; // Recency list links (entry indices, -1 = none)
+		int older = -1;
+		TArrayWrapper<float> distances;
+		TArrayWrapper<int> parents;
+	};
+
+	std::size_t memoryBudget;
+	TArrayWrapper<TEntry> entries;
+	TArrayWrapper<int> freeEntries;   // Evicted entries (their tables released), reused first
+	TArrayWrapper<int> entryOfSource; // Source id -> entry index, -1 = not cached
+	int entryCount;
+	int newest;
+	int oldest;
+	long long hits;
+	long long misses;
+	long long evictions;
+
+	/**
+	 * @brief The cached entry for (aSourceId, aVersion), counted as a hit (and made the newest) or a miss; -1 on a miss.
+	 */
+	int Lookup(int aSourceId, uint64_t aVersion);
+
+	void Unlink(int aIndex);
+	void PushNewest(int aIndex);
+	void Evict(int aIndex);
+
+public:
+	explicit TRoutingCache(std::size_t aMemoryBudget = kDefaultMemoryBudget);
+
+	TRoutingCache(const TRoutingCache&) = delete;
+	TRoutingCache& operator=(const TRoutingCache&) = delete;
+
+	/**
+	 * @brief Copies the cached table of aSourceId into aOutContext (O(V)), as if a full search had just run there.
+	 * @return False on a miss (aOutContext is then untouched).
+	 */
+	bool Load(int aSourceId, uint64_t aVersion, TQueryContext& aOutContext);
+
+	/**
+	 * @brief O(1) access to a cached table: aOutDistances[v] and aOutParents[v] for every vertex v.
+	 * The pointers stay valid until the next Store or Clear.
+	 * @return False on a miss.
+	 */
+	bool Find(int aSourceId, uint64_t aVersion, const float*& aOutDistances, const int*& aOutParents);
+
+	/**
+	 * @brief Caches the table of a context after a full search from its source, evicting the least recently used
+	 * tables if the budget is full. Does nothing if the budget cannot hold a single table.
+	 */
+	void Store(const TQueryContext& aContext, uint64_t aVersion);
+
+	/**
+	 * @brief Drops every table (the counters are kept).
+	 */
+	void Clear();
+
+	/**
+	 * @brief How many tables of aVertexCount vertices fit in the budget.
+	 */
+	int GetCapacity(int aVertexCount) const;
+
+	int GetEntryCount() const { return entryCount; }
+	long long GetHitCount() const { return hits; }
+	long long GetMissCount() const { return misses; }
+	long long GetEvictionCount() const { return evictions; }
+	std::size_t GetMemoryBudget() const { return memoryBudget; }
+};
+
+#endif // ROUTING_CACHE_H
@@ -48,6 +48,6 @@ int main(int argc, char* argv[])
 
 	// Create only core or common code in main.cpp
 	// Use the option header files to implement the specific assignment option logic
-	appStatus = RunApp();
+	appStatus = RunApp(argc, argv);
 	return appStatus;
 }
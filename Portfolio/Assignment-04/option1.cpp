@@ -1,6 +1,6 @@
 #include "option1.h"
 #include <iostream>
 
-int RunApp() {
+int RunApp(int, char*[]) {
 	return 0;
 }
\ No newline at end of file
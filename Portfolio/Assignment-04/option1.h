@@ -3,7 +3,7 @@
 #ifndef OPTION1_H
 #define OPTION1_H
 
-int RunApp();
+int RunApp(int argc, char* argv[]);
 
 
 #endif // OPTION1_H
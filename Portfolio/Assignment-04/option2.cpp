@@ -1,58 +1,419 @@
 #include "option2.h"
-#include "SharedLib.h"
 #include "Graph.h"
+#include "ContractionHierarchy.h"
+#include "DistanceMatrix.h"
+#include "RoutingCache.h"
+#include "RouteService.h"
+#include "RouteServer.h"
+#include "RadixTrie.hpp"
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
 #include <iostream>
 #include <string>
+#include <vector>
 
-// --- Global / Static Instance for Callbacks ---
-// We need this because the function pointers in SharedLib do not accept a context pointer.
-static TGraph* gGraphInstance = nullptr;
+// How many suggestions to list when the entered city is not an exact match
+static const int kSuggestionLimit = 10;
 
-// --- Callbacks ---
+/**
+ * @brief Lists the cities that start with aPrefix, so a partial name can be completed.
+ */
+static void PrintSuggestions(const TRadixTrie<int>& aCityNames, const std::string& aPrefix)
+{
+	std::cout << "No city named '" << aPrefix << "'.";
+	int shown = aCityNames.ForEachWithPrefix(aPrefix, kSuggestionLimit, [](const std::string& aName, const int&)
+		{
+			std::cout << "\n  " << aName;
+			return true;
+		});
+	if (shown == 0)
+	{
+		std::cout << " No city starts with it either.\n";
+	}
+	else
+	{
+		std::cout << (shown == kSuggestionLimit ? "\n  ...\n" : "\n");
+	}
+}
 
-static bool NodeReadCallback(const int aIndex, const int aTotalCount, const std::string& aNode)
+// Names of the numeric graph formats on the command line, in ENumericGraphFormat order
+static const char* const kNumericFormatNames[] = { "dimacs", "edges" };
+static constexpr int kNumericFormatCount = 2;
+
+static bool ParseNumericFormat(const std::string& aName, ENumericGraphFormat& aOutFormat)
 {
-	if (gGraphInstance)
+	for (int i = 0; i < kNumericFormatCount; i++)
 	{
-		// Just ensure the vertex is created/registered
-		gGraphInstance->CreateVertex(aNode);
+		if (aName == kNumericFormatNames[i])
+		{
+			aOutFormat = static_cast<ENumericGraphFormat>(i);
+			return true;
+		}
+	}
+	return false;
+}
+
+/**
+ * @brief Bulk-loads aFilename into aGraph and logs how long it took.
+ * @param aImportFormat Empty for the [NODES]/[EDGES] text format, else a numeric format name ("dimacs", "edges"),
+ * which comes out frozen.
+ */
+static bool ReadGraph(const std::string& aFilename, const std::string& aImportFormat, TGraph& aGraph, std::ostream& aLog)
+{
+	aLog << "Reading graph from: " << aFilename << " ...\n";
+	auto start = std::chrono::steady_clock::now();
+	ENumericGraphFormat format = ENumericGraphFormat::Dimacs;
+	bool isLoaded = aImportFormat.empty() ? aGraph.LoadTextGraph(aFilename)
+		: (ParseNumericFormat(aImportFormat, format) && aGraph.LoadNumericGraph(aFilename, format));
+	if (!isLoaded || aGraph.IsEmpty()) {
+		aLog << "Error: Graph is empty. Check file path.\n";
+		return false;
 	}
+	double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+	aLog << "Graph Loaded Successfully (" << aGraph.GetVertexCount() << " cities, " << aGraph.GetEdgeCount()
+		<< " roads in " << seconds << " s).\n";
 	return true;
 }
 
-static bool EdgeReadCallback(const int aIndex, const int aTotalCount, const std::string& aFrom, const std::string& aTo, float aWeight)
+/**
+ * @brief Reads the graph and prepares it for queries: the name index and the contraction hierarchy
+ * are loaded from next to the graph file, or built and saved there. Progress goes to aLog.
+ * @param aOrder Vertex numbering applied when the graph is frozen.
+ * @param aImportFormat Numeric format of the file (see ReadGraph), or empty.
+ */
+static bool LoadGraph(const std::string& aFilename, EVertexOrder aOrder, const std::string& aImportFormat, TGraph& aGraph,
+	TContractionHierarchy& aHierarchy, std::ostream& aLog)
 {
-	if (gGraphInstance)
+	aGraph.SetVertexOrder(aOrder);
+	if (!ReadGraph(aFilename, aImportFormat, aGraph, aLog))
+	{
+		return false;
+	}
+
+	// The city set is final now: reuse the name index saved next to the graph, or build and save it
+	// (an imported graph built its index while loading, faster than a file could be checked)
+	std::string indexFilename = aFilename + ".vidx";
+	if (!aGraph.IsFrozen() && !aGraph.LoadNameIndex(indexFilename))
 	{
-		// Add the directed edge
-		gGraphInstance->AddEdge(aFrom, aTo, aWeight);
+		aGraph.Freeze();
+		aGraph.SaveNameIndex(indexFilename);
 	}
+	aLog << "City name index ready.\n";
+
+	// Routes go through a contraction hierarchy, also cached next to the graph
+	std::string hierarchyFilename = aFilename + ".chx";
+	if (!aHierarchy.Load(hierarchyFilename, aGraph))
+	{
+		aHierarchy.Build(aGraph);
+		aHierarchy.Save(hierarchyFilename);
+	}
+	aGraph.SetContractionHierarchy(&aHierarchy);
+	aGraph.SetRouteAlgorithm(ERouteAlgorithm::ContractionHierarchy);
+	aLog << "Contraction hierarchy ready (" << aHierarchy.GetShortcutCount() << " shortcuts).\n";
 	return true;
 }
 
-// --- Main App ---
+/**
+ * @brief Headless mode: answers the "From;To" lines of aQueryFilename ("-" = standard input) on all threads
+ * and writes the routes to aOutputFilename (empty = standard output). Progress and statistics go to std::cerr.
+ */
+static int RunBatch(const std::string& aFilename, EVertexOrder aOrder, const std::string& aImportFormat, const std::string& aQueryFilename, const std::string& aOutputFilename, int aThreadCount)
+{
+	TGraph graph;
+	TContractionHierarchy hierarchy;
+	if (!LoadGraph(aFilename, aOrder, aImportFormat, graph, hierarchy, std::cerr))
+	{
+		return 1;
+	}
+
+	std::ifstream queryFile;
+	if (aQueryFilename != "-")
+	{
+		queryFile.open(aQueryFilename);
+		if (!queryFile)
+		{
+			std::cerr << "Error: Cannot open query file '" << aQueryFilename << "'." << std::endl;
+			return 1;
+		}
+	}
+	std::ofstream outputFile;
+	if (!aOutputFilename.empty())
+	{
+		outputFile.open(aOutputFilename);
+		if (!outputFile)
+		{
+			std::cerr << "Error: Cannot create output file '" << aOutputFilename << "'." << std::endl;
+			return 1;
+		}
+	}
 
-int RunApp()
+	TRouteService service(graph, aThreadCount);
+	std::cerr << "Answering queries on " << service.GetThreadCount() << " threads ...\n";
+	TRouteServiceStats stats = service.Run(queryFile.is_open() ? static_cast<std::istream&>(queryFile) : std::cin,
+		outputFile.is_open() ? static_cast<std::ostream&>(outputFile) : std::cout);
+	TRouteService::PrintStats(stats, std::cerr);
+	return 0;
+}
+
+/**
+ * @brief Server mode: keeps the graph loaded and answers the clients of aSocketPath until one sends SHUTDOWN.
+ */
+static int RunServer(const std::string& aFilename, EVertexOrder aOrder, const std::string& aImportFormat, const std::string& aSocketPath, int aThreadCount)
 {
-	// 1. Initialize Graph
 	TGraph graph;
-	gGraphInstance = &graph; // Point the static global to our local instance
+	TContractionHierarchy hierarchy;
+	if (!LoadGraph(aFilename, aOrder, aImportFormat, graph, hierarchy, std::cerr))
+	{
+		return 1;
+	}
 
-	std::cout << "Option 2 (Advanced): Inter-city Logistics Router.\n";
+	TRouteServer server(graph, aThreadCount);
+	std::cerr << "Serving on " << aSocketPath << " with " << server.GetThreadCount() << " threads (send SHUTDOWN to stop) ...\n";
+	if (!server.Run(aSocketPath))
+	{
+		return 1;
+	}
+	TRouteServer::PrintStats(server.GetStats(), std::cerr);
+	return 0;
+}
 
-	// 2. Load Data
-	// Note: Update this path if your data is elsewhere. 
+/**
+ * @brief Load generator: replays the queries of aQueryFilename against the server on aSocketPath.
+ */
+static int RunLoad(const std::string& aSocketPath, const std::string& aQueryFilename, int aConnectionCount, int aPipelineDepth)
+{
+	std::ifstream queryFile(aQueryFilename);
+	if (!queryFile)
+	{
+		std::cerr << "Error: Cannot open query file '" << aQueryFilename << "'." << std::endl;
+		return 1;
+	}
+	std::vector<std::string> queries;
+	std::string line;
+	while (std::getline(queryFile, line))
+	{
+		if (!line.empty() && line.back() == '\r') line.pop_back();
+		if (!line.empty() && line[0] != '#') queries.push_back(line);
+	}
+
+	std::cerr << "Sending " << queries.size() << " queries over " << aConnectionCount << " connections ...\n";
+	TRouteServiceStats stats;
+	bool isDone = RunRouteLoad(aSocketPath, queries, aConnectionCount, aPipelineDepth, stats);
+	TRouteService::PrintStats(stats, std::cerr);
+	return isDone ? 0 : 1;
+}
+
+// Names of the vertex orders on the command line, in EVertexOrder order
+static const char* const kVertexOrderNames[] = { "input", "bfs", "rcm", "degree" };
+static constexpr int kVertexOrderCount = 4;
+
+static bool ParseVertexOrder(const std::string& aName, EVertexOrder& aOutOrder)
+{
+	for (int i = 0; i < kVertexOrderCount; i++)
+	{
+		if (aName == kVertexOrderNames[i])
+		{
+			aOutOrder = static_cast<EVertexOrder>(i);
+			return true;
+		}
+	}
+	return false;
+}
+
+/**
+ * @brief Breadth-first search over the out-edges from aStartId.
+ * @return The number of vertices reached.
+ */
+static int CountReachable(const TAdjacencyView& aView, int aStartId, std::vector<uint8_t>& aIsVisited, std::vector<int>& aQueue)
+{
+	aIsVisited.assign(static_cast<std::size_t>(aView.vertexCount), 0);
+	aQueue.clear();
+	aQueue.push_back(aStartId);
+	aIsVisited[static_cast<std::size_t>(aStartId)] = 1;
+	for (std::size_t head = 0; head < aQueue.size(); head++)
+	{
+		int v = aQueue[head];
+		for (uint32_t e = aView.offsets[v]; e < aView.offsets[v + 1]; e++)
+		{
+			uint32_t target = aView.targets[e];
+			if (aIsVisited[target] == 0)
+			{
+				aIsVisited[target] = 1;
+				aQueue.push_back(static_cast<int>(target));
+			}
+		}
+	}
+	return static_cast<int>(aQueue.size());
+}
+
+/**
+ * @brief Benchmark mode: freezes the graph with every vertex order in turn and times the same Dijkstra
+ * and BFS runs on each. The average edge span |from id - to id| shows how close an order put neighbours.
+ */
+static int RunOrderBenchmark(const std::string& aFilename, const std::string& aImportFormat, int aRunCount)
+{
+	TGraph graph;
+	if (!ReadGraph(aFilename, aImportFormat, graph, std::cout))
+	{
+		return 1;
+	}
+
+	// The same start cities for every order, spread over the file
+	std::vector<std::string> starts;
+	for (int i = 0; i < aRunCount; i++)
+	{
+		starts.push_back(graph.GetVertexName(static_cast<int>(static_cast<long long>(i) * graph.GetVertexCount() / aRunCount)));
+	}
+
+	std::cout << graph.GetVertexCount() << " cities, " << graph.GetEdgeCount() << " roads, " << aRunCount << " runs per order.\n"
+		<< "order   freeze ms  edge span  Dijkstra ms/run  BFS ms/run  reached\n";
+	TQueryContext context;
+	std::vector<uint8_t> isVisited;
+	std::vector<int> queue;
+	for (int o = 0; o < kVertexOrderCount; o++)
+	{
+		graph.SetVertexOrder(static_cast<EVertexOrder>(o));
+		auto start = std::chrono::steady_clock::now();
+		graph.Freeze();
+		double freezeMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+		TAdjacencyView view = graph.GetAdjacency();
+		double span = 0.0;
+		for (int v = 0; v < view.vertexCount; v++)
+		{
+			for (uint32_t e = view.offsets[v]; e < view.offsets[v + 1]; e++)
+			{
+				span += std::abs(static_cast<double>(v) - static_cast<double>(view.targets[e]));
+			}
+		}
+		span /= (view.edgeCount > 0) ? view.edgeCount : 1;
+
+		// One untimed run of each first, so the first order does not pay for growing the search state
+		graph.RunDijkstra(starts[0], context);
+		CountReachable(view, graph.GetVertexId(starts[0]), isVisited, queue);
+
+		long long reached = 0;
+		start = std::chrono::steady_clock::now();
+		for (const std::string& name : starts)
+		{
+			graph.RunDijkstra(name, context);
+			reached += context.GetReachedCount();
+		}
+		double dijkstraMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+		start = std::chrono::steady_clock::now();
+		for (const std::string& name : starts)
+		{
+			reached += CountReachable(view, graph.GetVertexId(name), isVisited, queue);
+		}
+		double bfsMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+		std::cout << std::left << std::setw(8) << kVertexOrderNames[o] << std::right << std::fixed << std::setprecision(1)
+			<< std::setw(9) << freezeMs << std::setw(11) << span << std::setprecision(3)
+			<< std::setw(17) << dijkstraMs / aRunCount << std::setw(12) << bfsMs / aRunCount
+			<< std::setw(9) << reached << "\n";
+		std::cout.unsetf(std::ios::fixed);
+	}
+	return 0;
+}
+
+// --- Main App ---
+
+int RunApp(int argc, char* argv[])
+{
+	// Note: Update this path if your data is elsewhere (or pass --graph <file>).
 	// The assignment requires using "city_graph.txt" which is a Directed Graph.
 	std::string filename = "F:\\IKT203\\VisualStudio\\DATA\\city_graph.txt";
 
-	std::cout << "Reading graph from: " << filename << " ...\n";
-	readGraphFromFile(filename, NodeReadCallback, EdgeReadCallback);
+	// Command line: --batch <file|-> [--output <file>] [--threads N] switches to the headless query service,
+	// --serve <socket> [--threads N] to the query server and --load <socket> --batch <file> to its load generator.
+	// --order <input|bfs|rcm|degree> numbers the vertices for locality; --benchmark N compares the orders.
+	// --import <dimacs|edges> reads a numeric graph file (DIMACS .gr or an edge list) instead of the text format.
+	// --matrix <file> keeps the all-pairs matrix of the 'all' command in that file (8 bytes per pair of cities).
+	std::string queryFilename;
+	std::string matrixFilename;
+	std::string outputFilename;
+	std::string serveSocket;
+	std::string loadSocket;
+	int threadCount = 0;
+	int connectionCount = 4;
+	int pipelineDepth = 16;
+	int benchmarkRuns = 0;
+	EVertexOrder vertexOrder = EVertexOrder::Input;
+	std::string importFormat;
+	ENumericGraphFormat numericFormat = ENumericGraphFormat::Dimacs;
+	bool isValid = true;
+	for (int i = 1; i < argc; i += 2)
+	{
+		std::string option = argv[i];
+		bool hasValue = (i + 1 < argc);
+		if (hasValue && option == "--graph") filename = argv[i + 1];
+		else if (hasValue && option == "--batch") queryFilename = argv[i + 1];
+		else if (hasValue && option == "--output") outputFilename = argv[i + 1];
+		else if (hasValue && option == "--threads") threadCount = std::atoi(argv[i + 1]);
+		else if (hasValue && option == "--serve") serveSocket = argv[i + 1];
+		else if (hasValue && option == "--load") loadSocket = argv[i + 1];
+		else if (hasValue && option == "--connections") connectionCount = std::atoi(argv[i + 1]);
+		else if (hasValue && option == "--depth") pipelineDepth = std::atoi(argv[i + 1]);
+		else if (hasValue && option == "--order") isValid = ParseVertexOrder(argv[i + 1], vertexOrder);
+		else if (hasValue && option == "--benchmark") benchmarkRuns = std::atoi(argv[i + 1]);
+		else if (hasValue && option == "--matrix") matrixFilename = argv[i + 1];
+		else if (hasValue && option == "--import") { importFormat = argv[i + 1]; isValid = ParseNumericFormat(importFormat, numericFormat); }
+		else isValid = false;
+		if (!isValid)
+		{
+			std::cerr << "Usage: " << argv[0] << " [--graph <file>] [--batch <file|-> [--output <file>] [--threads N]]\n"
+				<< "       " << argv[0] << " [--graph <file>] --serve <socket> [--threads N]\n"
+				<< "       " << argv[0] << " --load <socket> --batch <file> [--connections N] [--depth N]\n"
+				<< "       " << argv[0] << " [--graph <file>] --benchmark <runs>\n"
+				<< "       " << argv[0] << " [--graph <file>] [--matrix <file>]\n"
+				<< "Any mode that loads the graph takes --order <input|bfs|rcm|degree> and --import <dimacs|edges>." << std::endl;
+			return 1;
+		}
+	}
+	if (benchmarkRuns > 0)
+	{
+		return RunOrderBenchmark(filename, importFormat, benchmarkRuns);
+	}
+	if (!serveSocket.empty())
+	{
+		return RunServer(filename, vertexOrder, importFormat, serveSocket, threadCount);
+	}
+	if (!loadSocket.empty())
+	{
+		return RunLoad(loadSocket, queryFilename, connectionCount, pipelineDepth);
+	}
+	if (!queryFilename.empty())
+	{
+		return RunBatch(filename, vertexOrder, importFormat, queryFilename, outputFilename, threadCount);
+	}
+
+	// 1. Initialize Graph
+	TGraph graph;
+
+	std::cout << "Option 2 (Advanced): Inter-city Logistics Router.\n";
 
-	if (graph.IsEmpty()) {
-		std::cout << "Error: Graph is empty. Check file path.\n";
+	// 2. Load Data
+	TContractionHierarchy hierarchy;
+	if (!LoadGraph(filename, vertexOrder, importFormat, graph, hierarchy, std::cout))
+	{
 		return 1;
 	}
-	std::cout << "Graph Loaded Successfully.\n\n";
+	std::cout << "\n";
+
+	// For completing partial city names
+	TRadixTrie<int> cityNames;
+	for (int i = 0; i < graph.GetVertexCount(); i++)
+	{
+		cityNames.Insert(graph.GetVertexName(i), i);
+	}
+
+	// Start cities asked for again are answered from memory (until the budget is full, then least recently used first)
+	TRoutingCache routingCache;
+	graph.SetRoutingCache(&routingCache);
 
 	graph.PrintVertices();
 
@@ -60,22 +421,76 @@ int RunApp()
 	std::string input;
 	while (true)
 	{
-		std::cout << "Enter Start City (or 'exit'): ";
+		std::cout << "Enter Start City ('all' for every pair, 'exit' to quit): ";
 		if (!std::getline(std::cin, input) || input == "exit")
 		{
 			break;
 		}
 		if (input.empty()) continue;
 
-		// 4. Run Algorithm
-		if (graph.RunDijkstra(input))
+		// All-pairs mode: the routing matrix of every source, built on all cores (and kept in the --matrix file, if given)
+		if (input == "all" && !cityNames.Contains(input))
+		{
+			TDistanceMatrix matrix;
+			if (matrixFilename.empty() || !matrix.Open(matrixFilename, graph))
+			{
+				if (!matrix.Build(graph, true))
+				{
+					continue;
+				}
+				if (!matrixFilename.empty())
+				{
+					std::cout << "Saving the matrix to " << matrixFilename << " (" << matrix.GetFileSize() << " bytes).\n";
+					if (!matrix.Save(matrixFilename))
+					{
+						std::cerr << "Error: Could not write " << matrixFilename << "." << std::endl;
+					}
+				}
+			}
+			matrix.Print(graph);
+			continue;
+		}
+
+		// Not a city: suggest the ones it could be the start of
+		if (!cityNames.Contains(input))
+		{
+			PrintSuggestions(cityNames, input);
+			continue;
+		}
+
+		// 4. Optional destination: one route instead of the whole routing table
+		std::string destination;
+		std::cout << "Enter Destination City (or press Enter for all cities): ";
+		if (!std::getline(std::cin, destination))
+		{
+			break;
+		}
+		if (!destination.empty())
+		{
+			if (!cityNames.Contains(destination))
+			{
+				PrintSuggestions(cityNames, destination);
+				continue;
+			}
+			TRoute route;
+			if (graph.ShortestPath(input, destination, route))
+			{
+				graph.PrintRoute(route);
+			}
+			continue;
+		}
+
+		// 5. Run Algorithm (large graphs spread the search over all cores)
+		bool isSolved = (graph.GetVertexCount() >= TGraph::kDeltaSteppingMinVertices)
+			? graph.RunDeltaStepping(input)
+			: graph.RunDijkstra(input);
+		if (isSolved)
 		{
-			// 5. Display Results
+			// 6. Display Results
 			graph.PrintRoutingTable();
 		}
 	}
 
-	// Reset static pointer
-	gGraphInstance = nullptr;
+	std::cout << "Routing cache: " << routingCache.GetHitCount() << " hits, " << routingCache.GetMissCount() << " misses.\n";
 	return 0;
 }
\ No newline at end of file
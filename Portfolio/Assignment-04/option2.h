@@ -3,7 +3,7 @@
 #ifndef OPTION2_H
 #define OPTION2_H
 
-int RunApp();
+int RunApp(int argc, char* argv[]);
 
 
 #endif // OPTION2_H
@@ -1,60 +1,226 @@
 #pragma once
 
+#include <new>
 #include <stdexcept>
 #include <type_traits>
+#include <utility>
 
 template <typename T>
 class TArrayWrapper
 {
+public:
+	// Alignment used when aIsSimdAligned is requested (one cache line, enough for AVX-512 loads)
+	static constexpr int kSimdAlignment = 64;
+
 private:
-	T* items;           // Pointer to the data on the heap
+	T* items;           // Pointer to the data on the heap (raw storage, only [0, count) is constructed)
 	int count;          // How many items are currently in the array
-	int size;           // The total size (capacity) of the array
-	bool isDataOwner;  // Flag for memory management
+	int capacity;       // How many items fit before the storage has to grow
+	bool isDataOwner;   // Flag for memory management
+	int alignment;      // Alignment of the storage block in bytes
+
+	T* Allocate(int aCapacity) const {
+		if (aCapacity <= 0) {
+			return nullptr;
+		}
+		const std::size_t bytes = sizeof(T) * static_cast<std::size_t>(aCapacity);
+		return static_cast<T*>(::operator new(bytes, std::align_val_t(static_cast<std::size_t>(alignment))));
+	}
+
+	void Deallocate(T* aItems) const {
+		if (aItems != nullptr) {
+			::operator delete(aItems, std::align_val_t(static_cast<std::size_t>(alignment)));
+		}
+	}
+
+	void DestroyItems() {
+		for (int i = 0; i < count; i++) {
+			items[i].~T();
+		}
+		count = 0;
+	}
+
+	/**
+	 * @brief Moves the live items into a fresh block of aNewCapacity items.
+	 */
+	void Relocate(int aNewCapacity) {
+		T* newItems = Allocate(aNewCapacity);
+		for (int i = 0; i < count; i++) {
+			new (newItems + i) T(std::move(items[i]));
+			items[i].~T();
+		}
+		Deallocate(items);
+		items = newItems;
+		capacity = aNewCapacity;
+	}
+
+	int GrowthTarget(int aRequired) const {
+		// Geometric growth keeps Add amortised O(1)
+		int target = capacity < 4 ? 4 : capacity * 2;
+		return target < aRequired ? aRequired : target;
+	}
+
 public:
 	/**
-	 * @brief Constructor for a fixed-size array.
-	 * @param aSize The exact number of items this array will hold.
+	 * @brief Constructor for a growable array.
+	 * @param aCapacity Initial number of items to reserve room for (0 = allocate on first Add).
 	 * @param aIsDataOwner True if this array owns and must delete the T* data.
+	 * @param aIsSimdAligned True to align the storage on kSimdAlignment bytes for vectorised loops.
 	 */
-	TArrayWrapper(int aSize, bool aIsDataOwner = false)
-		: items(nullptr), count(0), size(aSize), isDataOwner(aIsDataOwner)
+	explicit TArrayWrapper(int aCapacity = 0, bool aIsDataOwner = false, bool aIsSimdAligned = false)
+		: items(nullptr), count(0), capacity(0), isDataOwner(aIsDataOwner),
+		alignment(aIsSimdAligned && kSimdAlignment > static_cast<int>(alignof(T)) ? kSimdAlignment : static_cast<int>(alignof(T)))
 	{
-		if (aIsOwner && !std::is_pointer<T>::value) {
+		if (aIsDataOwner && !std::is_pointer<T>::value) {
 			throw std::invalid_argument("TArrayWrapper: aIsDataOwner can only be true for pointer types.");
 		}
-		if (aSize <= 0) {
-			throw std::invalid_argument("TArrayWrapper: Size must be greater than zero.");
+		if (aCapacity < 0) {
+			throw std::invalid_argument("TArrayWrapper: Capacity cannot be negative.");
 		}
-		// Allocate memory for the array ONCE!
-		items = new T[aSize];
+		Reserve(aCapacity);
 	}
+
+	// Copying would either share or double-delete owned pointers, so the array is move-only
+	TArrayWrapper(const TArrayWrapper&) = delete;
+	TArrayWrapper& operator=(const TArrayWrapper&) = delete;
+
+	TArrayWrapper(TArrayWrapper&& aOther) noexcept
+		: items(aOther.items), count(aOther.count), capacity(aOther.capacity),
+		isDataOwner(aOther.isDataOwner), alignment(aOther.alignment)
+	{
+		aOther.items = nullptr;
+		aOther.count = 0;
+		aOther.capacity = 0;
+	}
+
+	TArrayWrapper& operator=(TArrayWrapper&& aOther) noexcept {
+		if (this != &aOther) {
+			Clear();
+			Deallocate(items);
+			items = aOther.items;
+			count = aOther.count;
+			capacity = aOther.capacity;
+			isDataOwner = aOther.isDataOwner;
+			alignment = aOther.alignment;
+			aOther.items = nullptr;
+			aOther.count = 0;
+			aOther.capacity = 0;
+		}
+		return *this;
+	}
+
 	/**
-		 * @brief Destructor.
-		 */
+	 * @brief Destructor. Deletes the pointees first if this array owns them.
+	 */
 	~TArrayWrapper() {
-		//TODO: Implement destructor to free memory if isDataOwner is true
+		Clear();
+		Deallocate(items);
+	}
 
-		// Always delete the array container itself
-		delete[] items;
+	/**
+	 * @brief Removes all items (deleting owned pointees) but keeps the storage.
+	 */
+	void Clear() {
+		if constexpr (std::is_pointer<T>::value) {
+			if (isDataOwner) {
+				for (int i = 0; i < count; i++) {
+					delete items[i];
+				}
+			}
+		}
+		DestroyItems();
 	}
 
-	void Add(const T aItem) {
-		if (count >= size) {
-			throw std::out_of_range("TArrayWrapper: Cannot add more items, array is full.");
+	/**
+	 * @brief Makes room for at least aCapacity items without changing the count.
+	 */
+	void Reserve(int aCapacity) {
+		if (aCapacity > capacity) {
+			Relocate(aCapacity);
 		}
-		items[count++] = aItem;
 	}
 
-	// ... (operator[] and GetCount() remain the same) ...
-	const T& operator[](int index) {
-		if (index < 0 || index >= count) {
+	/**
+	 * @brief Releases unused capacity.
+	 */
+	void ShrinkToFit() {
+		if (count < capacity) {
+			Relocate(count);
+		}
+	}
+
+	/**
+	 * @brief Grows or shrinks the array to aCount items; new slots are copies of aFill.
+	 * Shrinking does not delete owned pointees, ownership of those passes to the caller.
+	 */
+	void Resize(int aCount, const T& aFill = T()) {
+		if (aCount < 0) {
+			throw std::invalid_argument("TArrayWrapper: Count cannot be negative.");
+		}
+		Reserve(aCount);
+		while (count > aCount) {
+			items[--count].~T();
+		}
+		while (count < aCount) {
+			new (items + count) T(aFill);
+			count++;
+		}
+	}
+
+	/**
+	 * @brief Constructs a new item in place at the end of the array.
+	 */
+	template <typename... TArgs>
+	T& Emplace(TArgs&&... aArgs) {
+		if (count < capacity) {
+			new (items + count) T(std::forward<TArgs>(aArgs)...);
+		}
+		else {
+			// Build the new item before moving the old ones, the arguments may refer into this array
+			int newCapacity = GrowthTarget(count + 1);
+			T* newItems = Allocate(newCapacity);
+			new (newItems + count) T(std::forward<TArgs>(aArgs)...);
+			for (int i = 0; i < count; i++) {
+				new (newItems + i) T(std::move(items[i]));
+				items[i].~T();
+			}
+			Deallocate(items);
+			items = newItems;
+			capacity = newCapacity;
+		}
+		return items[count++];
+	}
+
+	void Add(const T& aItem) {
+		Emplace(aItem);
+	}
+
+	void Add(T&& aItem) {
+		Emplace(std::move(aItem));
+	}
+
+	/**
+	 * @brief Removes and returns the last item. Owned pointees are handed back, not deleted.
+	 */
+	T RemoveLast() {
+		if (count == 0) {
+			throw std::out_of_range("TArrayWrapper: Cannot remove from an empty array.");
+		}
+		T result = std::move(items[count - 1]);
+		items[--count].~T();
+		return result;
+	}
+
+	T& operator[](int aIndex)
+	{
+		if (aIndex < 0 || aIndex >= count)
+		{
 			throw std::out_of_range("TArrayWrapper: Index out of range.");
 		}
-		return items[index];
+		return items[aIndex];
 	}
 
-	T& operator[](int aIndex) const
+	const T& operator[](int aIndex) const
 	{
 		if (aIndex < 0 || aIndex >= count)
 		{
@@ -63,7 +229,31 @@ public:
 		return items[aIndex];
 	}
 
+	/**
+	 * @brief Raw access to the contiguous storage, for tight loops that skip the bounds check.
+	 */
+	T* GetData() { return items; }
+	const T* GetData() const { return items; }
+
+	// Range-for support
+	T* begin() { return items; }
+	T* end() { return items + count; }
+	const T* begin() const { return items; }
+	const T* end() const { return items + count; }
+
 	int GetCount() const {
 		return count;
 	}
-};
\ No newline at end of file
+
+	int GetCapacity() const {
+		return capacity;
+	}
+
+	bool IsEmpty() const {
+		return count == 0;
+	}
+
+	int GetAlignment() const {
+		return alignment;
+	}
+};
@@ -2,8 +2,12 @@
 #ifndef BINARY_SEARCH_TABLE_HPP
 #define BINARY_SEARCH_TABLE_HPP
 
+#include <new>
+#include <stdexcept>
 #include <string>
-#include <iostream>
+#include <string_view>
+#include <utility>
+#include "ArrayWrapper.hpp"
 
 /**
  * @brief Generic Node for the Binary Search Table.
@@ -17,7 +21,7 @@ struct TBinarySearchTreeNode {
 	TBinarySearchTreeNode* right;
 
 	TBinarySearchTreeNode(std::string aKey, T aValue)
-		: key(aKey), value(aValue), left(nullptr), right(nullptr) {
+		: key(std::move(aKey)), value(std::move(aValue)), left(nullptr), right(nullptr) {
 	}
 };
 
@@ -25,67 +29,246 @@ struct TBinarySearchTreeNode {
  * @brief A Generic BST.
  * Manages memory for the Nodes.
  * Note: Does not assume ownership of T (if T is a pointer) to keep it compatible with primitives (double).
+ *
+ * Insert and Search are iterative, so depth never touches the call stack. The tree stays balanced
+ * as a scapegoat tree: when an insert lands deeper than log(n) / log(1 / kAlpha), the lowest
+ * unbalanced ancestor's subtree is rebuilt into a perfectly balanced one. Sorted input therefore
+ * no longer degenerates into a list. Nodes come from an arena of fixed-size blocks,
+ * so neighbours in insertion order are also neighbours in memory.
  */
 template <typename T>
 class TBinarySearchTable {
 private:
-	TBinarySearchTreeNode<T>* root;
+	using TNode = TBinarySearchTreeNode<T>;
 
-	// --- Recursive Helpers ---
+	static constexpr int kArenaBlockSize = 256;
+	// Balance factor: a child may hold at most this share of its parent's subtree
+	static constexpr double kAlpha = 0.7;
 
-	void DeleteSubtree(TBinarySearchTreeNode<T>* aNode) {
-		if (aNode == nullptr) return;
-		// Post-order deletion
-		DeleteSubtree(aNode->left);
-		DeleteSubtree(aNode->right);
-		delete aNode;
+	TNode* root;
+	int count;
+
+	// --- Node Arena ---
+	TArrayWrapper<TNode*> blocks; // Raw blocks of kArenaBlockSize nodes
+	int usedInLastBlock;
+
+	TNode* NewNode(std::string_view aKey, T aValue) {
+		if (blocks.IsEmpty() || usedInLastBlock == kArenaBlockSize) {
+			blocks.Add(static_cast<TNode*>(::operator new(sizeof(TNode) * kArenaBlockSize)));
+			usedInLastBlock = 0;
+		}
+		TNode* node = blocks[blocks.GetCount() - 1] + usedInLastBlock;
+		new (node) TNode(std::string(aKey), std::move(aValue));
+		usedInLastBlock++;
+		return node;
 	}
 
-	void InsertNode(TBinarySearchTreeNode<T>*& aNode, const std::string& aKey, T aValue) {
-		if (aNode == nullptr) {
-			aNode = new TBinarySearchTreeNode<T>(aKey, aValue);
+	void FreeArena() {
+		for (int b = 0; b < blocks.GetCount(); b++) {
+			int used = (b == blocks.GetCount() - 1) ? usedInLastBlock : kArenaBlockSize;
+			for (int i = 0; i < used; i++) {
+				blocks[b][i].~TNode();
+			}
+			::operator delete(blocks[b]);
 		}
-		else if (aKey < aNode->key) {
-			InsertNode(aNode->left, aKey, aValue);
+		blocks.Clear();
+		usedInLastBlock = 0;
+		root = nullptr;
+		count = 0;
+	}
+
+	// --- Balancing Helpers ---
+
+	/**
+	 * @brief Largest depth allowed for a tree of aCount nodes: floor(log_{1/alpha}(aCount)).
+	 */
+	static int MaxDepth(int aCount) {
+		int depth = 0;
+		double reach = 1.0;
+		while (reach * (1.0 / kAlpha) <= aCount) {
+			reach *= 1.0 / kAlpha;
+			depth++;
 		}
-		else if (aKey > aNode->key) {
-			InsertNode(aNode->right, aKey, aValue);
+		return depth;
+	}
+
+	/**
+	 * @brief Counts the nodes of a subtree without recursion.
+	 */
+	int SubtreeSize(TNode* aNode) {
+		int size = 0;
+		TArrayWrapper<TNode*> stack;
+		if (aNode != nullptr) stack.Add(aNode);
+		while (!stack.IsEmpty()) {
+			TNode* node = stack.RemoveLast();
+			size++;
+			if (node->left != nullptr) stack.Add(node->left);
+			if (node->right != nullptr) stack.Add(node->right);
 		}
-		else {
-			// Key exists; update value
-			aNode->value = aValue;
+		return size;
+	}
+
+	/**
+	 * @brief Appends a subtree's nodes in key order (iterative in-order walk).
+	 */
+	static void Flatten(TNode* aNode, TArrayWrapper<TNode*>& aOut) {
+		TArrayWrapper<TNode*> stack;
+		TNode* current = aNode;
+		while (current != nullptr || !stack.IsEmpty()) {
+			while (current != nullptr) {
+				stack.Add(current);
+				current = current->left;
+			}
+			current = stack.RemoveLast();
+			aOut.Add(current);
+			current = current->right;
 		}
 	}
 
-	bool SearchNode(TBinarySearchTreeNode<T>* aNode, const std::string& aKey, T& aOutValue) const {
-		if (aNode == nullptr) {
-			return false;
+	/**
+	 * @brief Links sorted nodes [aFirst, aLast) into a perfectly balanced subtree. Recursion depth is log2(n).
+	 */
+	static TNode* LinkBalanced(TNode** aNodes, int aFirst, int aLast) {
+		if (aFirst >= aLast) return nullptr;
+		int mid = aFirst + (aLast - aFirst) / 2;
+		TNode* node = aNodes[mid];
+		node->left = LinkBalanced(aNodes, aFirst, mid);
+		node->right = LinkBalanced(aNodes, mid + 1, aLast);
+		return node;
+	}
+
+	TNode* Rebuild(TNode* aSubtree) {
+		TArrayWrapper<TNode*> nodes;
+		Flatten(aSubtree, nodes);
+		return LinkBalanced(nodes.GetData(), 0, nodes.GetCount());
+	}
+
+	/**
+	 * @brief Walks up an insertion path to the scapegoat and rebuilds it.
+	 * aPath holds the nodes from the root down to (and including) the new leaf.
+	 */
+	void RebalanceAlong(TArrayWrapper<TNode*>& aPath) {
+		int childSize = 1;
+		for (int i = aPath.GetCount() - 2; i >= 0; i--) {
+			TNode* node = aPath[i];
+			TNode* child = aPath[i + 1];
+			TNode* sibling = (node->left == child) ? node->right : node->left;
+			int size = childSize + SubtreeSize(sibling) + 1;
+			if (childSize > kAlpha * size) {
+				TNode* rebuilt = Rebuild(node);
+				if (i == 0) {
+					root = rebuilt;
+				}
+				else if (aPath[i - 1]->left == node) {
+					aPath[i - 1]->left = rebuilt;
+				}
+				else {
+					aPath[i - 1]->right = rebuilt;
+				}
+				return;
+			}
+			childSize = size;
 		}
-		if (aKey == aNode->key) {
-			aOutValue = aNode->value;
-			return true;
+	}
+
+public:
+	TBinarySearchTable() : root(nullptr), count(0), usedInLastBlock(0) {}
+
+	~TBinarySearchTable() {
+		FreeArena();
+	}
+
+	TBinarySearchTable(const TBinarySearchTable&) = delete;
+	TBinarySearchTable& operator=(const TBinarySearchTable&) = delete;
+
+	void Insert(std::string_view aKey, T aValue) {
+		TArrayWrapper<TNode*> path(MaxDepth(count + 1) + 2);
+		TNode** link = &root;
+		while (*link != nullptr) {
+			TNode* node = *link;
+			int order = aKey.compare(node->key);
+			if (order == 0) {
+				// Key exists; update value
+				node->value = std::move(aValue);
+				return;
+			}
+			path.Add(node);
+			link = (order < 0) ? &node->left : &node->right;
 		}
-		else if (aKey < aNode->key) {
-			return SearchNode(aNode->left, aKey, aOutValue);
+		*link = NewNode(aKey, std::move(aValue));
+		path.Add(*link);
+		count++;
+
+		// Depth of the new node is path count - 1
+		if (path.GetCount() - 1 > MaxDepth(count)) {
+			RebalanceAlong(path);
 		}
-		else {
-			return SearchNode(aNode->right, aKey, aOutValue);
+	}
+
+	bool Search(std::string_view aKey, T& aOutValue) const {
+		TNode* node = root;
+		while (node != nullptr) {
+			int order = aKey.compare(node->key);
+			if (order == 0) {
+				aOutValue = node->value;
+				return true;
+			}
+			node = (order < 0) ? node->left : node->right;
 		}
+		return false;
 	}
 
-public:
-	TBinarySearchTable() : root(nullptr) {}
+	/**
+	 * @brief Replaces the contents with the given entries, linked into a perfectly balanced tree in O(n).
+	 * @param aBegin, aEnd A range of pairs (key, value), e.g. std::pair<std::string, T>, sorted by key
+	 * with no duplicates.
+	 */
+	template <typename TIterator>
+	void BuildFromSorted(TIterator aBegin, TIterator aEnd) {
+		FreeArena();
+		TArrayWrapper<TNode*> nodes;
+		for (TIterator it = aBegin; it != aEnd; ++it) {
+			std::string_view key = it->first;
+			if (!nodes.IsEmpty() && !(std::string_view(nodes[nodes.GetCount() - 1]->key) < key)) {
+				FreeArena();
+				throw std::invalid_argument("TBinarySearchTable: BuildFromSorted needs strictly ascending keys.");
+			}
+			nodes.Add(NewNode(key, it->second));
+		}
+		count = nodes.GetCount();
+		root = LinkBalanced(nodes.GetData(), 0, nodes.GetCount());
+	}
 
-	~TBinarySearchTable() {
-		DeleteSubtree(root);
+	/**
+	 * @brief Calls aVisit(key, value) for every entry in key order.
+	 */
+	template <typename TVisitor>
+	void ForEach(TVisitor&& aVisit) const {
+		TArrayWrapper<TNode*> nodes(count);
+		Flatten(root, nodes);
+		for (TNode* node : nodes) {
+			aVisit(node->key, node->value);
+		}
 	}
 
-	void Insert(const std::string& aKey, T aValue) {
-		InsertNode(root, aKey, aValue);
+	/**
+	 * @brief Height of the tree (0 when empty), useful to check the balance.
+	 */
+	int GetHeight() const {
+		int height = 0;
+		TArrayWrapper<std::pair<TNode*, int>> stack;
+		if (root != nullptr) stack.Add(std::make_pair(root, 1));
+		while (!stack.IsEmpty()) {
+			std::pair<TNode*, int> entry = stack.RemoveLast();
+			if (entry.second > height) height = entry.second;
+			if (entry.first->left != nullptr) stack.Add(std::make_pair(entry.first->left, entry.second + 1));
+			if (entry.first->right != nullptr) stack.Add(std::make_pair(entry.first->right, entry.second + 1));
+		}
+		return height;
 	}
 
-	bool Search(const std::string& aKey, T& aOutValue) const {
-		return SearchNode(root, aKey, aOutValue);
+	int GetCount() const {
+		return count;
 	}
 
 	bool IsEmpty() const {
@@ -93,4 +276,4 @@ public:
 	}
 };
 
-#endif // BINARY_SEARCH_TABLE_HPP
\ No newline at end of file
+#endif // BINARY_SEARCH_TABLE_HPP
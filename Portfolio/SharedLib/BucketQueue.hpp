@@ -0,0 +1,88 @@
+#pragma once
+#ifndef BUCKET_QUEUE_HPP
+#define BUCKET_QUEUE_HPP
+
+#include <cstdint>
+#include <stdexcept>
+#include <utility>
+#include "ArrayWrapper.hpp"
+
+/**
+ * @brief Dial's bucket queue for small non-negative integer keys.
+ * While the queue is monotone and every queued key is within aMaxSpan of the current minimum
+ * (true for Dijkstra when aMaxSpan is the largest edge weight), a circular array of aMaxSpan + 1
+ * buckets is enough and both Enqueue and Dequeue are O(1) amortised.
+ */
+template <typename T>
+class TBucketQueue {
+private:
+	TArrayWrapper<TArrayWrapper<T>> buckets;
+	uint32_t currentKey; // Smallest key that can still be in the queue
+	int bucketCount;
+	int count;
+
+public:
+	/**
+	 * @param aMaxSpan Largest difference between any queued key and the current minimum.
+	 */
+	explicit TBucketQueue(uint32_t aMaxSpan)
+		: buckets(static_cast<int>(aMaxSpan) + 1), currentKey(0), bucketCount(static_cast<int>(aMaxSpan) + 1), count(0) {
+		for (int i = 0; i < bucketCount; i++) {
+			buckets.Emplace();
+		}
+	}
+
+	bool IsEmpty() const {
+		return count == 0;
+	}
+
+	int GetCount() const {
+		return count;
+	}
+
+	uint32_t GetMaxSpan() const {
+		return static_cast<uint32_t>(bucketCount - 1);
+	}
+
+	/**
+	 * @brief Removes every item and restarts the key window at 0, keeping the buckets for reuse.
+	 * Only the buckets that can still hold items are visited.
+	 */
+	void Clear() {
+		int slot = static_cast<int>(currentKey % static_cast<uint32_t>(bucketCount));
+		while (count > 0) {
+			count -= buckets[slot].GetCount();
+			buckets[slot].Clear();
+			slot = (slot + 1 == bucketCount) ? 0 : slot + 1;
+		}
+		currentKey = 0;
+	}
+
+	void Enqueue(T aData, uint32_t aKey) {
+		if (aKey < currentKey || aKey - currentKey >= static_cast<uint32_t>(bucketCount)) {
+			throw std::out_of_range("Bucket Queue: Key is outside the current window");
+		}
+		buckets[static_cast<int>(aKey % static_cast<uint32_t>(bucketCount))].Add(std::move(aData));
+		count++;
+	}
+
+	/**
+	 * @brief Removes an item with the smallest key.
+	 * @param aOutKey Receives the key of the removed item.
+	 */
+	T Dequeue(uint32_t& aOutKey) {
+		if (IsEmpty()) {
+			throw std::underflow_error("Bucket Queue Underflow");
+		}
+		int slot = static_cast<int>(currentKey % static_cast<uint32_t>(bucketCount));
+		while (buckets[slot].IsEmpty()) {
+			currentKey++;
+			slot = (slot + 1 == bucketCount) ? 0 : slot + 1;
+		}
+		count--;
+		aOutKey = currentKey;
+		return buckets[slot].RemoveLast();
+	}
+};
+
+#endif // BUCKET_QUEUE_HPP
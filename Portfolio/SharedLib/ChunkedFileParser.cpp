@@ -0,0 +1,66 @@
+#include "ChunkedFileParser.h"
+#include <cstring>
+
+bool TChunkedFileParser::Open(const std::string& aFilename, std::size_t aChunkSize)
+{
+	Close();
+	if (!file.Open(aFilename))
+	{
+		return false;
+	}
+	if (aChunkSize == 0)
+	{
+		aChunkSize = kDefaultChunkSize;
+	}
+
+	// Every chunk but the last ends just after the first line break past its nominal size
+	const char* data = reinterpret_cast<const char*>(file.GetData());
+	const char* end = data + file.GetSize();
+	std::size_t start = 0;
+	chunkStarts.Add(0);
+	while (file.GetSize() - start > aChunkSize)
+	{
+		const char* lineEnd = FindLineEnd(data + start + aChunkSize, end);
+		if (lineEnd == end)
+		{
+			break;
+		}
+		start = static_cast<std::size_t>(lineEnd - data) + 1;
+		chunkStarts.Add(start);
+	}
+	if (chunkStarts[chunkStarts.GetCount() - 1] != file.GetSize())
+	{
+		chunkStarts.Add(file.GetSize());
+	}
+	return true;
+}
+
+void TChunkedFileParser::Close()
+{
+	file.Close();
+	chunkStarts.Clear();
+}
+
+void TChunkedFileParser::ParseChunks(TThreadPool& aPool, const FChunkBody& aBody) const
+{
+	const char* data = reinterpret_cast<const char*>(file.GetData());
+	aPool.ParallelFor(GetChunkCount(), [&](int aChunkIndex, int aThreadIndex)
+		{
+			aBody(data + chunkStarts[aChunkIndex], data + chunkStarts[aChunkIndex + 1], aChunkIndex, aThreadIndex);
+		});
+}
+
+void TChunkedFileParser::ParseChunksInOrder(const FChunkBody& aBody) const
+{
+	const char* data = reinterpret_cast<const char*>(file.GetData());
+	for (int i = 0; i < GetChunkCount(); i++)
+	{
+		aBody(data + chunkStarts[i], data + chunkStarts[i + 1], i, 0);
+	}
+}
+
+const char* TChunkedFileParser::FindLineEnd(const char* aCursor, const char* aEnd)
+{
+	const void* found = std::memchr(aCursor, '\n', static_cast<std::size_t>(aEnd - aCursor));
+	return (found != nullptr) ? static_cast<const char*>(found) : aEnd;
+}
@@ -0,0 +1,87 @@
+// ChunkedFileParser.h
+#pragma once
+#ifndef CHUNKED_FILE_PARSER_H
+#define CHUNKED_FILE_PARSER_H
+
+#include <charconv>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include "ArrayWrapper.hpp"
+#include "MappedFile.h"
+#include "ThreadPool.h"
+
+/**
+ * @brief Parses a large text file on all threads of a TThreadPool.
+ * The file is memory-mapped and cut into chunks of about aChunkSize bytes, each ending after a line
+ * break, so every chunk holds whole lines and can be parsed on its own. Chunks are numbered in file
+ * order: a body that writes its results to per-chunk storage gets the same result however the
+ * chunks were spread over the threads.
+ */
+class TChunkedFileParser
+{
+public:
+	static constexpr std::size_t kDefaultChunkSize = std::size_t(4) << 20;
+
+	// Chunk body: the lines in [aBegin, aEnd); aThreadIndex selects per-thread scratch state
+	typedef std::function<void(const char* aBegin, const char* aEnd, int aChunkIndex, int aThreadIndex)> FChunkBody;
+
+private:
+	TMappedFile file;
+	TArrayWrapper<std::size_t> chunkStarts; // Chunk c is [chunkStarts[c], chunkStarts[c + 1])
+
+public:
+	/**
+	 * @brief Maps aFilename and finds the chunk boundaries (one short scan per chunk for the next line break).
+	 * @return False if the file cannot be mapped (or is empty).
+	 */
+	bool Open(const std::string& aFilename, std::size_t aChunkSize = kDefaultChunkSize);
+
+	void Close();
+
+	int GetChunkCount() const { return chunkStarts.GetCount() > 0 ? chunkStarts.GetCount() - 1 : 0; }
+	std::size_t GetSize() const { return file.GetSize(); }
+
+	/**
+	 * @brief Calls aBody for every chunk on the threads of aPool and returns when all are done.
+	 */
+	void ParseChunks(TThreadPool& aPool, const FChunkBody& aBody) const;
+
+	/**
+	 * @brief Calls aBody for every chunk on the calling thread, in file order (aThreadIndex is 0).
+	 */
+	void ParseChunksInOrder(const FChunkBody& aBody) const;
+
+	// --- Field readers for chunk bodies. Each skips the spaces, tabs and commas before the field,
+	// --- advances aCursor past it and returns false (leaving aCursor there) if there is no such field.
+
+	static void SkipSeparators(const char*& aCursor, const char* aEnd) {
+		while (aCursor < aEnd && (*aCursor == ' ' || *aCursor == '\t' || *aCursor == ',' || *aCursor == '\r')) {
+			aCursor++;
+		}
+	}
+
+	static bool ReadUnsigned(const char*& aCursor, const char* aEnd, uint64_t& aOutValue) {
+		SkipSeparators(aCursor, aEnd);
+		std::from_chars_result result = std::from_chars(aCursor, aEnd, aOutValue);
+		if (result.ec != std::errc()) return false;
+		aCursor = result.ptr;
+		return true;
+	}
+
+	static bool ReadFloat(const char*& aCursor, const char* aEnd, float& aOutValue) {
+		SkipSeparators(aCursor, aEnd);
+		std::from_chars_result result = std::from_chars(aCursor, aEnd, aOutValue);
+		if (result.ec != std::errc()) return false;
+		aCursor = result.ptr;
+		return true;
+	}
+
+	/**
+	 * @brief The end of the line starting at aCursor (its '\n', or aEnd for a last line without one).
+	 */
+	static const char* FindLineEnd(const char* aCursor, const char* aEnd);
+};
+
+#endif // CHUNKED_FILE_PARSER_H
@@ -0,0 +1,12 @@
+#pragma once
+#ifndef COMPARE_FUNCTION_HPP
+#define COMPARE_FUNCTION_HPP
+
+/**
+ * @brief Comparison callback shared by the sorting and selection engines.
+ * Returns true if the first item belongs before (or ties with) the second item.
+ */
+template <typename T>
+using FCompareFunction = bool(*)(const T, const T);
+
+#endif // COMPARE_FUNCTION_HPP
@@ -0,0 +1,253 @@
+#pragma once
+#ifndef HASH_MAP_HPP
+#define HASH_MAP_HPP
+
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <string_view>
+#include <utility>
+#include "ArrayWrapper.hpp"
+
+/**
+ * @brief 64-bit string hash (processes 8 bytes per step, then avalanches).
+ * Shared by the hash containers so they agree on how a name hashes.
+ */
+inline uint64_t HashString(std::string_view aKey, uint64_t aSeed = 0)
+{
+	const uint64_t kMultiplier = 0x9E3779B97F4A7C15ULL;
+	uint64_t hash = aSeed ^ (static_cast<uint64_t>(aKey.size()) * kMultiplier);
+	const char* data = aKey.data();
+	std::size_t remaining = aKey.size();
+	while (remaining >= 8) {
+		uint64_t chunk = 0;
+		std::memcpy(&chunk, data, 8);
+		hash = (hash ^ chunk) * kMultiplier;
+		hash ^= hash >> 29;
+		data += 8;
+		remaining -= 8;
+	}
+	if (remaining > 0) {
+		uint64_t chunk = 0;
+		std::memcpy(&chunk, data, remaining);
+		hash = (hash ^ chunk) * kMultiplier;
+		hash ^= hash >> 29;
+	}
+	// Final avalanche (splitmix64 finaliser)
+	hash ^= hash >> 30;
+	hash *= 0xBF58476D1CE4E5B9ULL;
+	hash ^= hash >> 27;
+	hash *= 0x94D049BB133111EBULL;
+	hash ^= hash >> 31;
+	return hash;
+}
+
+/**
+ * @brief A string-keyed hash map with open addressing and Robin Hood probing.
+ * Same role as TBinarySearchTable (name -> T), but lookups are O(1) on average regardless of
+ * insertion order. Entries live in one flat slot array; Robin Hood keeps probe sequences short
+ * by letting an entry that is far from its home slot take the place of one that is closer.
+ * Lookups take std::string_view, so callers do not need to build a std::string to search.
+ * Note: Does not assume ownership of T (if T is a pointer), like TBinarySearchTable.
+ */
+template <typename T>
+class THashMap {
+private:
+	struct TSlot {
+		std::string key;
+		T value{};
+		uint32_t hash = 0;      // Low bits of the full hash, compared before the key
+		int32_t distance = -1;  // Probe distance from the home slot, -1 = empty
+	};
+
+	TArrayWrapper<TSlot> slots;
+	int count;
+	int mask; // slot count - 1 (slot count is a power of two)
+
+	// Grow when the table is more than 7/8 full
+	static bool IsOverloaded(int aCount, int aSlotCount) {
+		return static_cast<long long>(aCount) * 8 > static_cast<long long>(aSlotCount) * 7;
+	}
+
+	static uint32_t ShortHash(std::string_view aKey) {
+		return static_cast<uint32_t>(HashString(aKey));
+	}
+
+	void Rehash(int aSlotCount) {
+		TArrayWrapper<TSlot> oldSlots(std::move(slots));
+		slots = TArrayWrapper<TSlot>(aSlotCount);
+		slots.Resize(aSlotCount);
+		mask = aSlotCount - 1;
+		count = 0;
+		for (TSlot& slot : oldSlots) {
+			if (slot.distance >= 0) {
+				Place(std::move(slot.key), std::move(slot.value), slot.hash);
+			}
+		}
+	}
+
+	/**
+	 * @brief Inserts a key that is known not to be present. Returns the slot index it ended up in.
+	 */
+	int Place(std::string&& aKey, T&& aValue, uint32_t aHash) {
+		TSlot incoming;
+		incoming.key = std::move(aKey);
+		incoming.value = std::move(aValue);
+		incoming.hash = aHash;
+		incoming.distance = 0;
+
+		TSlot* data = slots.GetData();
+		int index = static_cast<int>(aHash) & mask;
+		int placedAt = -1;
+		while (true) {
+			TSlot& slot = data[index];
+			if (slot.distance < 0) {
+				slot = std::move(incoming);
+				count++;
+				return placedAt < 0 ? index : placedAt;
+			}
+			if (slot.distance < incoming.distance) {
+				// Robin Hood: the richer entry gives up its slot and continues probing
+				std::swap(slot, incoming);
+				if (placedAt < 0) {
+					placedAt = index;
+				}
+			}
+			incoming.distance++;
+			index = (index + 1) & mask;
+		}
+	}
+
+	int FindIndex(std::string_view aKey) const {
+		if (count == 0) {
+			return -1;
+		}
+		uint32_t hash = ShortHash(aKey);
+		const TSlot* data = slots.GetData();
+		int index = static_cast<int>(hash) & mask;
+		for (int distance = 0; ; distance++) {
+			const TSlot& slot = data[index];
+			// Past this point the key would have displaced the slot's entry, so it is not here
+			if (slot.distance < distance) {
+				return -1;
+			}
+			if (slot.hash == hash && slot.key == aKey) {
+				return index;
+			}
+			index = (index + 1) & mask;
+		}
+	}
+
+public:
+	/**
+	 * @param aExpectedCount Number of entries to size the table for up front (0 = start small).
+	 */
+	explicit THashMap(int aExpectedCount = 0) : count(0), mask(0) {
+		Reserve(aExpectedCount < 8 ? 8 : aExpectedCount);
+	}
+
+	/**
+	 * @brief Sizes the table so aExpectedCount entries fit without rehashing.
+	 */
+	void Reserve(int aExpectedCount) {
+		int slotCount = (slots.GetCount() > 0) ? slots.GetCount() : 8;
+		while (IsOverloaded(aExpectedCount, slotCount)) {
+			slotCount *= 2;
+		}
+		if (slotCount != slots.GetCount()) {
+			Rehash(slotCount);
+		}
+	}
+
+	/**
+	 * @brief Inserts or updates a key.
+	 */
+	void Insert(std::string_view aKey, T aValue) {
+		int index = FindIndex(aKey);
+		if (index >= 0) {
+			// Key exists; update value
+			slots[index].value = std::move(aValue);
+			return;
+		}
+		if (IsOverloaded(count + 1, slots.GetCount())) {
+			Rehash(slots.GetCount() * 2);
+		}
+		Place(std::string(aKey), std::move(aValue), ShortHash(aKey));
+	}
+
+	/**
+	 * @brief Returns a pointer to the stored value, or nullptr. Valid until the next insert or remove.
+	 */
+	T* Find(std::string_view aKey) {
+		int index = FindIndex(aKey);
+		return (index >= 0) ? &slots[index].value : nullptr;
+	}
+
+	const T* Find(std::string_view aKey) const {
+		int index = FindIndex(aKey);
+		return (index >= 0) ? &slots[index].value : nullptr;
+	}
+
+	/**
+	 * @brief TBinarySearchTable-compatible lookup.
+	 */
+	bool Search(std::string_view aKey, T& aOutValue) const {
+		const T* value = Find(aKey);
+		if (value == nullptr) {
+			return false;
+		}
+		aOutValue = *value;
+		return true;
+	}
+
+	bool Contains(std::string_view aKey) const {
+		return FindIndex(aKey) >= 0;
+	}
+
+	/**
+	 * @brief Removes a key with backward-shift deletion (no tombstones).
+	 * @return True if the key was present.
+	 */
+	bool Remove(std::string_view aKey) {
+		int index = FindIndex(aKey);
+		if (index < 0) {
+			return false;
+		}
+		TSlot* data = slots.GetData();
+		int next = (index + 1) & mask;
+		// Pull following entries one step closer to home until one is already home (or a gap)
+		while (data[next].distance > 0) {
+			data[index] = std::move(data[next]);
+			data[index].distance--;
+			index = next;
+			next = (next + 1) & mask;
+		}
+		data[index].key.clear();
+		data[index].value = T();
+		data[index].distance = -1;
+		count--;
+		return true;
+	}
+
+	int GetCount() const {
+		return count;
+	}
+
+	bool IsEmpty() const {
+		return count == 0;
+	}
+
+	/**
+	 * @brief Calls aVisit(key, value) for every entry, in table order.
+	 */
+	template <typename TVisitor>
+	void ForEach(TVisitor&& aVisit) const {
+		for (const TSlot& slot : slots) {
+			if (slot.distance >= 0) {
+				aVisit(slot.key, slot.value);
+			}
+		}
+	}
+};
+
+#endif // HASH_MAP_HPP
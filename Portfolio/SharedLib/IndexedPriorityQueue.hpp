@@ -0,0 +1,202 @@
+#pragma once
+#ifndef INDEXED_PRIORITY_QUEUE_HPP
+#define INDEXED_PRIORITY_QUEUE_HPP
+
+#include <stdexcept>
+#include "ArrayWrapper.hpp"
+
+/**
+ * @brief A d-ary Min-Heap over integer item ids in [0, aMaxId) with decrease-key.
+ * A position map (id -> heap slot) lets us find and update an item that is already queued,
+ * so every id is in the heap at most once and the heap never holds more than aMaxId entries.
+ * Keys are stored per heap slot next to the ids, so sifting compares packed floats
+ * instead of chasing id -> priority for every child.
+ */
+template <int Arity = 2>
+class TIndexedPriorityQueue {
+	static_assert(Arity >= 2, "TIndexedPriorityQueue: Arity must be at least 2");
+
+private:
+	TArrayWrapper<float> heapKeys; // Heap slot -> priority
+	TArrayWrapper<int> heapIds;    // Heap slot -> item id
+	TArrayWrapper<int> positions;  // Item id -> heap slot, or -1 if not queued
+
+	/**
+	 * @brief Writes an item into a heap slot and records where it went.
+	 */
+	void Place(int aSlot, int aId, float aPriority) {
+		heapKeys.GetData()[aSlot] = aPriority;
+		heapIds.GetData()[aSlot] = aId;
+		positions.GetData()[aId] = aSlot;
+	}
+
+	/**
+	 * @brief Moves the hole at aSlot up until aPriority fits, then returns the final slot.
+	 */
+	int SiftUpHole(int aSlot, float aPriority) {
+		float* keys = heapKeys.GetData();
+		int* ids = heapIds.GetData();
+		int* slots = positions.GetData();
+		while (aSlot > 0) {
+			int parentSlot = (aSlot - 1) / Arity;
+			if (!(aPriority < keys[parentSlot])) {
+				break;
+			}
+			keys[aSlot] = keys[parentSlot];
+			ids[aSlot] = ids[parentSlot];
+			slots[ids[aSlot]] = aSlot;
+			aSlot = parentSlot;
+		}
+		return aSlot;
+	}
+
+	/**
+	 * @brief Moves the hole at aSlot down until aPriority fits, then returns the final slot.
+	 */
+	int SiftDownHole(int aSlot, float aPriority) {
+		float* keys = heapKeys.GetData();
+		int* ids = heapIds.GetData();
+		int* slots = positions.GetData();
+		int count = heapKeys.GetCount();
+		while (true) {
+			int firstChild = aSlot * Arity + 1;
+			if (firstChild >= count) {
+				break;
+			}
+			int lastChild = firstChild + Arity;
+			if (lastChild > count) {
+				lastChild = count;
+			}
+			int smallest = firstChild;
+			for (int child = firstChild + 1; child < lastChild; child++) {
+				if (keys[child] < keys[smallest]) {
+					smallest = child;
+				}
+			}
+			if (!(keys[smallest] < aPriority)) {
+				break;
+			}
+			keys[aSlot] = keys[smallest];
+			ids[aSlot] = ids[smallest];
+			slots[ids[aSlot]] = aSlot;
+			aSlot = smallest;
+		}
+		return aSlot;
+	}
+
+	void CheckId(int aId) const {
+		if (aId < 0 || aId >= positions.GetCount()) {
+			throw std::out_of_range("Indexed Priority Queue: Item id out of range");
+		}
+	}
+
+public:
+	/**
+	 * @param aMaxId One past the largest item id that will be queued (e.g. the vertex count).
+	 */
+	explicit TIndexedPriorityQueue(int aMaxId)
+		: heapKeys(aMaxId), heapIds(aMaxId), positions(aMaxId) {
+		positions.Resize(aMaxId, -1);
+	}
+
+	bool IsEmpty() const {
+		return heapIds.IsEmpty();
+	}
+
+	/**
+	 * @brief One past the largest id the queue accepts.
+	 */
+	int GetMaxId() const {
+		return positions.GetCount();
+	}
+
+	/**
+	 * @brief Removes every queued item in O(queued items), keeping the storage for reuse.
+	 */
+	void Clear() {
+		for (int id : heapIds) {
+			positions[id] = -1;
+		}
+		heapKeys.Clear();
+		heapIds.Clear();
+	}
+
+	int GetCount() const {
+		return heapIds.GetCount();
+	}
+
+	bool Contains(int aId) const {
+		CheckId(aId);
+		return positions[aId] >= 0;
+	}
+
+	/**
+	 * @brief Queues a new item. The item must not already be in the queue.
+	 */
+	void Enqueue(int aId, float aPriority) {
+		if (Contains(aId)) {
+			throw std::invalid_argument("Indexed Priority Queue: Item is already queued");
+		}
+		int slot = heapIds.GetCount();
+		heapKeys.Add(aPriority);
+		heapIds.Add(aId);
+		Place(SiftUpHole(slot, aPriority), aId, aPriority);
+	}
+
+	/**
+	 * @brief Lowers the priority of a queued item and moves it up accordingly.
+	 */
+	void DecreaseKey(int aId, float aPriority) {
+		if (!Contains(aId)) {
+			throw std::invalid_argument("Indexed Priority Queue: Item is not queued");
+		}
+		int slot = positions[aId];
+		if (aPriority > heapKeys[slot]) {
+			throw std::invalid_argument("Indexed Priority Queue: New priority is larger than the current one");
+		}
+		Place(SiftUpHole(slot, aPriority), aId, aPriority);
+	}
+
+	/**
+	 * @brief O(1) access to the item with the lowest priority.
+	 */
+	int PeekId() const {
+		if (IsEmpty()) {
+			throw std::underflow_error("Indexed Priority Queue Underflow");
+		}
+		return heapIds[0];
+	}
+
+	float PeekPriority() const {
+		if (IsEmpty()) {
+			throw std::underflow_error("Indexed Priority Queue Underflow");
+		}
+		return heapKeys[0];
+	}
+
+	/**
+	 * @brief The current priority of a queued item.
+	 */
+	float GetPriority(int aId) const {
+		if (!Contains(aId)) {
+			throw std::invalid_argument("Indexed Priority Queue: Item is not queued");
+		}
+		return heapKeys[positions[aId]];
+	}
+
+	int Dequeue() {
+		int result = PeekId();
+		positions[result] = -1;
+
+		// Take the last element out and sift the root hole down to where it fits
+		float lastKey = heapKeys.RemoveLast();
+		int lastId = heapIds.RemoveLast();
+		if (!heapIds.IsEmpty()) {
+			Place(SiftDownHole(0, lastKey), lastId, lastKey);
+		}
+
+		return result;
+	}
+};
+
+#endif // INDEXED_PRIORITY_QUEUE_HPP
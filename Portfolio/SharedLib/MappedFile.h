@@ -0,0 +1,49 @@
+// MappedFile.h
+#pragma once
+#ifndef MAPPED_FILE_H
+#define MAPPED_FILE_H
+
+#include <cstddef>
+#include <string>
+
+/**
+ * @brief A read-only memory mapping of a whole file.
+ * Used to load prebuilt binary indexes without copying them: the OS pages the data in on demand
+ * and several processes mapping the same file share the physical pages.
+ */
+class TMappedFile
+{
+private:
+	const unsigned char* data;
+	std::size_t size;
+#ifdef _WIN32
+	void* fileHandle;
+	void* mappingHandle;
+#else
+	int fileDescriptor;
+#endif
+
+public:
+	TMappedFile();
+	~TMappedFile();
+
+	TMappedFile(const TMappedFile&) = delete;
+	TMappedFile& operator=(const TMappedFile&) = delete;
+
+	/**
+	 * @brief Maps aFilename read-only. Any previous mapping is closed first.
+	 * @return False if the file cannot be opened or mapped (or is empty).
+	 */
+	bool Open(const std::string& aFilename);
+
+	/**
+	 * @brief Unmaps the file. Pointers obtained from GetData() become invalid.
+	 */
+	void Close();
+
+	bool IsOpen() const { return data != nullptr; }
+	const unsigned char* GetData() const { return data; }
+	std::size_t GetSize() const { return size; }
+};
+
+#endif // MAPPED_FILE_H
@@ -1,8 +1,6 @@
 #pragma once
 #include "LinkedList.hpp"
-
-template <typename T>
-using FCompareFunction = bool(*)(const T, const T);
+#include "CompareFunction.hpp"
 
 template <typename T>
 class TMergeSort
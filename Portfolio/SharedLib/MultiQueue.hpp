@@ -0,0 +1,193 @@
+#pragma once
+#ifndef MULTI_QUEUE_HPP
+#define MULTI_QUEUE_HPP
+
+#include <atomic>
+#include <cstdint>
+#include <limits>
+#include <mutex>
+#include <stdexcept>
+#include <utility>
+#include "ArrayWrapper.hpp"
+#include "PriorityQueue.hpp"
+
+/**
+ * @brief Per-thread counters of a TMultiQueue. Only the owning thread writes them.
+ */
+struct TMultiQueueStats {
+	long long pushes = 0;
+	long long pops = 0;
+	long long emptyPops = 0;   // TryPop calls that found nothing
+	long long lockRetries = 0; // Times a sampled queue was locked by another thread
+};
+
+/**
+ * @brief A relaxed concurrent Min-Heap (MultiQueue).
+ * Holds c * P independently locked d-ary heaps for P threads. Push goes to a random heap; TryPop
+ * samples two heaps and pops from the one whose top is smaller ("power of two choices").
+ * Pops are approximate: the returned item is close to, but not always exactly, the global minimum,
+ * which label-correcting searches tolerate. Every call takes the calling thread's index in
+ * [0, aThreadCount) so random state and statistics stay thread-private.
+ */
+template <typename T>
+class TMultiQueue {
+private:
+	// Each heap sits on its own cache lines so two threads locking neighbours do not false-share
+	struct alignas(64) TLockedHeap {
+		std::mutex lock;
+		TPriorityQueue<T, 4> heap;
+		std::atomic<float> topPriority{ std::numeric_limits<float>::infinity() }; // Read without the lock when sampling
+	};
+
+	struct alignas(64) TThreadSlot {
+		uint64_t randomState = 0;
+		TMultiQueueStats stats;
+	};
+
+	TLockedHeap* heaps;
+	int heapCount;
+	TArrayWrapper<TThreadSlot> threadSlots;
+	std::atomic<int> approximateCount{ 0 };
+
+	static constexpr float kEmpty = std::numeric_limits<float>::infinity();
+
+	/**
+	 * @brief xorshift64* step, cheap enough to call on every operation.
+	 */
+	int RandomHeap(TThreadSlot& aSlot) {
+		uint64_t x = aSlot.randomState;
+		x ^= x >> 12;
+		x ^= x << 25;
+		x ^= x >> 27;
+		aSlot.randomState = x;
+		return static_cast<int>((x * 2685821657736338717ULL) >> 33) % heapCount;
+	}
+
+	TThreadSlot& Slot(int aThreadIndex) {
+		if (aThreadIndex < 0 || aThreadIndex >= threadSlots.GetCount()) {
+			throw std::out_of_range("Multi Queue: Thread index out of range");
+		}
+		return threadSlots[aThreadIndex];
+	}
+
+	void UpdateTop(TLockedHeap& aHeap) {
+		aHeap.topPriority.store(aHeap.heap.IsEmpty() ? kEmpty : aHeap.heap.PeekPriority(), std::memory_order_relaxed);
+	}
+
+	/**
+	 * @brief Pops from aHeap if it can be locked right away and is not empty.
+	 */
+	bool TryPopFrom(TLockedHeap& aHeap, TThreadSlot& aSlot, T& aOutData, float& aOutPriority) {
+		std::unique_lock<std::mutex> guard(aHeap.lock, std::try_to_lock);
+		if (!guard.owns_lock()) {
+			aSlot.stats.lockRetries++;
+			return false;
+		}
+		if (aHeap.heap.IsEmpty()) {
+			return false;
+		}
+		aOutPriority = aHeap.heap.PeekPriority();
+		aOutData = aHeap.heap.Dequeue();
+		UpdateTop(aHeap);
+		guard.unlock();
+		approximateCount.fetch_sub(1, std::memory_order_relaxed);
+		aSlot.stats.pops++;
+		return true;
+	}
+
+public:
+	/**
+	 * @param aThreadCount Number of threads that will call Push/TryPop (P).
+	 * @param aHeapsPerThread The factor c; 2 to 4 keeps contention low while staying close to exact order.
+	 */
+	TMultiQueue(int aThreadCount, int aHeapsPerThread = 2)
+		: heaps(nullptr), heapCount(0), threadSlots(aThreadCount) {
+		if (aThreadCount <= 0 || aHeapsPerThread <= 0) {
+			throw std::invalid_argument("Multi Queue: Thread count and heaps per thread must be positive");
+		}
+		heapCount = aThreadCount * aHeapsPerThread;
+		heaps = new TLockedHeap[heapCount];
+		for (int i = 0; i < aThreadCount; i++) {
+			TThreadSlot& slot = threadSlots.Emplace();
+			slot.randomState = 0x9E3779B97F4A7C15ULL * static_cast<uint64_t>(i + 1);
+		}
+	}
+
+	~TMultiQueue() {
+		delete[] heaps;
+	}
+
+	TMultiQueue(const TMultiQueue&) = delete;
+	TMultiQueue& operator=(const TMultiQueue&) = delete;
+
+	void Push(int aThreadIndex, T aData, float aPriority) {
+		TThreadSlot& slot = Slot(aThreadIndex);
+		// Count first, so a concurrent reader never sees zero while an item is on its way in
+		approximateCount.fetch_add(1, std::memory_order_relaxed);
+		while (true) {
+			TLockedHeap& target = heaps[RandomHeap(slot)];
+			std::unique_lock<std::mutex> guard(target.lock, std::try_to_lock);
+			if (!guard.owns_lock()) {
+				slot.stats.lockRetries++;
+				continue;
+			}
+			target.heap.Enqueue(std::move(aData), aPriority);
+			UpdateTop(target);
+			break;
+		}
+		slot.stats.pushes++;
+	}
+
+	/**
+	 * @brief Pops an item with a small (approximately minimal) priority.
+	 * @return False if no item was found; the queue is then empty or nearly so.
+	 */
+	bool TryPop(int aThreadIndex, T& aOutData, float& aOutPriority) {
+		TThreadSlot& slot = Slot(aThreadIndex);
+		for (int attempt = 0; attempt < 8; attempt++) {
+			TLockedHeap& first = heaps[RandomHeap(slot)];
+			TLockedHeap& second = heaps[RandomHeap(slot)];
+			float firstTop = first.topPriority.load(std::memory_order_relaxed);
+			float secondTop = second.topPriority.load(std::memory_order_relaxed);
+			if (firstTop == kEmpty && secondTop == kEmpty) {
+				if (approximateCount.load(std::memory_order_relaxed) <= 0) {
+					break;
+				}
+				continue;
+			}
+			TLockedHeap& best = (secondTop < firstTop) ? second : first;
+			if (TryPopFrom(best, slot, aOutData, aOutPriority)) {
+				return true;
+			}
+		}
+		// Sampling missed: sweep every heap once before reporting empty
+		for (int i = 0; i < heapCount; i++) {
+			if (heaps[i].topPriority.load(std::memory_order_relaxed) != kEmpty
+				&& TryPopFrom(heaps[i], slot, aOutData, aOutPriority)) {
+				return true;
+			}
+		}
+		slot.stats.emptyPops++;
+		return false;
+	}
+
+	/**
+	 * @brief Number of queued items. Exact only when no other thread is pushing or popping.
+	 */
+	int GetApproximateCount() const {
+		return approximateCount.load(std::memory_order_relaxed);
+	}
+
+	int GetThreadCount() const {
+		return threadSlots.GetCount();
+	}
+
+	/**
+	 * @brief Statistics of one thread. Read them after the worker threads have been joined.
+	 */
+	const TMultiQueueStats& GetStats(int aThreadIndex) const {
+		return threadSlots[aThreadIndex].stats;
+	}
+};
+
+#endif // MULTI_QUEUE_HPP
@@ -0,0 +1,322 @@
+#include "PerfectHash.h"
+#include "HashMap.hpp" // HashString
+#include <cstring>
+
+namespace
+{
+	// Average keys per bucket; 16-bit pilots / 4 keys = 4 bits per key
+	constexpr double kKeysPerBucket = 4.0;
+	// Table slack: with 1% spare slots the last buckets still find a pilot quickly
+	constexpr double kLoadFactor = 0.99;
+	constexpr int kMaxSeedAttempts = 32;
+	constexpr uint32_t kMaxPilot = 0xFFFF;
+	constexpr uint32_t kSmallSetSize = 64;
+
+	const char kMagic[4] = { 'M', 'P', 'H', '1' };
+
+	struct TSerializedHeader
+	{
+		char magic[4];
+		uint32_t keyCount;
+		uint32_t tableSize;
+		uint32_t bucketCount;
+		uint64_t seed;
+	};
+
+	uint64_t MixPilot(uint64_t aPilot)
+	{
+		uint64_t x = (aPilot + 1) * 0x9E3779B97F4A7C15ULL;
+		x ^= x >> 31;
+		x *= 0xBF58476D1CE4E5B9ULL;
+		x ^= x >> 29;
+		return x;
+	}
+
+	std::size_t AlignTo8(std::size_t aSize)
+	{
+		return (aSize + 7) & ~static_cast<std::size_t>(7);
+	}
+}
+
+TMinimalPerfectHash::TMinimalPerfectHash()
+	: seed(0), keyCount(0), tableSize(0), bucketCount(0), pilots(nullptr), remap(nullptr)
+{
+}
+
+uint32_t TMinimalPerfectHash::BucketOf(uint64_t aHash) const
+{
+	// Skewed split (PTHash): 60% of the keys go to the first 30% of the buckets,
+	// which gives the large-bucket-first search more room and shortens pilot searches.
+	uint32_t denseBuckets = static_cast<uint32_t>(bucketCount * 0.3);
+	if (denseBuckets == 0) denseBuckets = 1;
+	uint32_t low = static_cast<uint32_t>(aHash);
+	uint32_t high = static_cast<uint32_t>(aHash >> 32);
+	if (low < static_cast<uint32_t>(0.6 * 4294967296.0) || denseBuckets == bucketCount)
+	{
+		return high % denseBuckets;
+	}
+	return denseBuckets + high % (bucketCount - denseBuckets);
+}
+
+uint64_t TMinimalPerfectHash::SlotOf(uint64_t aHash, uint16_t aPilot) const
+{
+	return (aHash ^ MixPilot(aPilot)) % tableSize;
+}
+
+bool TMinimalPerfectHash::TryBuild(const uint64_t* aHashes)
+{
+	// 1. Bucket the keys (counting sort by bucket)
+	TArrayWrapper<uint32_t> bucketStart;
+	bucketStart.Resize(static_cast<int>(bucketCount) + 1, 0);
+	for (uint32_t i = 0; i < keyCount; i++)
+	{
+		bucketStart[static_cast<int>(BucketOf(aHashes[i])) + 1]++;
+	}
+	for (uint32_t b = 0; b < bucketCount; b++)
+	{
+		bucketStart[static_cast<int>(b) + 1] += bucketStart[static_cast<int>(b)];
+	}
+	TArrayWrapper<uint32_t> bucketKeys;
+	bucketKeys.Resize(static_cast<int>(keyCount), 0);
+	{
+		TArrayWrapper<uint32_t> fill;
+		fill.Resize(static_cast<int>(bucketCount), 0);
+		for (uint32_t i = 0; i < keyCount; i++)
+		{
+			uint32_t b = BucketOf(aHashes[i]);
+			bucketKeys[static_cast<int>(bucketStart[static_cast<int>(b)] + fill[static_cast<int>(b)]++)] = i;
+		}
+	}
+
+	// 2. Order buckets by size, largest first (counting sort on size)
+	uint32_t largest = 0;
+	for (uint32_t b = 0; b < bucketCount; b++)
+	{
+		uint32_t bucketSize = bucketStart[static_cast<int>(b) + 1] - bucketStart[static_cast<int>(b)];
+		if (bucketSize > largest) largest = bucketSize;
+	}
+	TArrayWrapper<uint32_t> sizeStart;
+	sizeStart.Resize(static_cast<int>(largest) + 2, 0);
+	for (uint32_t b = 0; b < bucketCount; b++)
+	{
+		uint32_t bucketSize = bucketStart[static_cast<int>(b) + 1] - bucketStart[static_cast<int>(b)];
+		sizeStart[static_cast<int>(largest - bucketSize) + 1]++;
+	}
+	for (uint32_t s = 0; s <= largest; s++)
+	{
+		sizeStart[static_cast<int>(s) + 1] += sizeStart[static_cast<int>(s)];
+	}
+	TArrayWrapper<uint32_t> order;
+	order.Resize(static_cast<int>(bucketCount), 0);
+	for (uint32_t b = 0; b < bucketCount; b++)
+	{
+		uint32_t bucketSize = bucketStart[static_cast<int>(b) + 1] - bucketStart[static_cast<int>(b)];
+		order[static_cast<int>(sizeStart[static_cast<int>(largest - bucketSize)]++)] = b;
+	}
+
+	// 3. Find a pilot per bucket that sends every key of the bucket to a free slot
+	TArrayWrapper<bool> taken;
+	taken.Resize(static_cast<int>(tableSize), false);
+	pilotStorage.Clear();
+	pilotStorage.Resize(static_cast<int>(bucketCount), 0);
+	TArrayWrapper<uint64_t> candidate;
+	candidate.Reserve(static_cast<int>(largest));
+
+	for (uint32_t index = 0; index < bucketCount; index++)
+	{
+		uint32_t b = order[static_cast<int>(index)];
+		uint32_t first = bucketStart[static_cast<int>(b)];
+		uint32_t last = bucketStart[static_cast<int>(b) + 1];
+		if (first == last) continue;
+
+		bool placed = false;
+		for (uint32_t pilot = 0; pilot <= kMaxPilot && !placed; pilot++)
+		{
+			candidate.Clear();
+			bool fits = true;
+			for (uint32_t k = first; k < last && fits; k++)
+			{
+				uint64_t slot = SlotOf(aHashes[bucketKeys[static_cast<int>(k)]], static_cast<uint16_t>(pilot));
+				if (taken[static_cast<int>(slot)])
+				{
+					fits = false;
+					break;
+				}
+				// Two keys of the same bucket must not collide with each other either
+				for (uint64_t other : candidate)
+				{
+					if (other == slot)
+					{
+						fits = false;
+						break;
+					}
+				}
+				candidate.Add(slot);
+			}
+			if (fits)
+			{
+				for (uint64_t slot : candidate)
+				{
+					taken[static_cast<int>(slot)] = true;
+				}
+				pilotStorage[static_cast<int>(b)] = static_cast<uint16_t>(pilot);
+				placed = true;
+			}
+		}
+		if (!placed)
+		{
+			return false;
+		}
+	}
+
+	// 4. Slots past keyCount are redirected to the holes left below keyCount
+	remapStorage.Clear();
+	uint32_t hole = 0;
+	for (uint32_t slot = keyCount; slot < tableSize; slot++)
+	{
+		uint32_t target = 0;
+		if (taken[static_cast<int>(slot)])
+		{
+			while (taken[static_cast<int>(hole)]) hole++;
+			target = hole++;
+		}
+		remapStorage.Add(target);
+	}
+	return true;
+}
+
+bool TMinimalPerfectHash::Build(const std::string_view* aKeys, int aCount)
+{
+	Clear();
+	if (aCount <= 0) return true;
+
+	keyCount = static_cast<uint32_t>(aCount);
+	tableSize = static_cast<uint32_t>(keyCount / kLoadFactor) + 1;
+	bucketCount = static_cast<uint32_t>(keyCount / kKeysPerBucket) + 1;
+	if (keyCount < kSmallSetSize)
+	{
+		// Tiny sets: one bucket per key, the metadata size does not matter here
+		bucketCount = keyCount;
+	}
+
+	TArrayWrapper<uint64_t> hashes;
+	hashes.Resize(aCount, 0);
+	for (int attempt = 0; attempt < kMaxSeedAttempts; attempt++)
+	{
+		seed = 0x5851F42D4C957F2DULL * static_cast<uint64_t>(attempt + 1);
+		for (int i = 0; i < aCount; i++)
+		{
+			hashes[i] = HashString(aKeys[i], seed);
+		}
+		if (TryBuild(hashes.GetData()))
+		{
+			pilots = pilotStorage.GetData();
+			remap = remapStorage.GetData();
+			return true;
+		}
+	}
+	// Every seed failed: the key set almost certainly contains duplicates
+	Clear();
+	return false;
+}
+
+int TMinimalPerfectHash::Lookup(std::string_view aKey) const
+{
+	if (keyCount == 0) return -1;
+	uint64_t hash = HashString(aKey, seed);
+	uint64_t slot = SlotOf(hash, pilots[BucketOf(hash)]);
+	if (slot >= keyCount)
+	{
+		return static_cast<int>(remap[slot - keyCount]);
+	}
+	return static_cast<int>(slot);
+}
+
+double TMinimalPerfectHash::GetBitsPerKey() const
+{
+	if (keyCount == 0) return 0.0;
+	double bits = 16.0 * bucketCount + 32.0 * (tableSize - keyCount);
+	return bits / keyCount;
+}
+
+std::size_t TMinimalPerfectHash::GetSerializedSize() const
+{
+	std::size_t size = sizeof(TSerializedHeader);
+	size += AlignTo8(sizeof(uint16_t) * bucketCount);
+	size += AlignTo8(sizeof(uint32_t) * (tableSize - keyCount));
+	return size;
+}
+
+void TMinimalPerfectHash::Serialize(std::ostream& aOut) const
+{
+	TSerializedHeader header;
+	std::memcpy(header.magic, kMagic, sizeof(kMagic));
+	header.keyCount = keyCount;
+	header.tableSize = tableSize;
+	header.bucketCount = bucketCount;
+	header.seed = seed;
+	aOut.write(reinterpret_cast<const char*>(&header), sizeof(header));
+
+	const char padding[8] = {};
+	std::size_t pilotBytes = sizeof(uint16_t) * bucketCount;
+	if (pilotBytes > 0) aOut.write(reinterpret_cast<const char*>(pilots), static_cast<std::streamsize>(pilotBytes));
+	aOut.write(padding, static_cast<std::streamsize>(AlignTo8(pilotBytes) - pilotBytes));
+	std::size_t remapBytes = sizeof(uint32_t) * (tableSize - keyCount);
+	if (remapBytes > 0) aOut.write(reinterpret_cast<const char*>(remap), static_cast<std::streamsize>(remapBytes));
+	aOut.write(padding, static_cast<std::streamsize>(AlignTo8(remapBytes) - remapBytes));
+}
+
+bool TMinimalPerfectHash::Attach(const unsigned char* aData, std::size_t aSize)
+{
+	Clear();
+	TSerializedHeader header;
+	if (aData == nullptr || aSize < sizeof(header)) return false;
+	std::memcpy(&header, aData, sizeof(header));
+	if (std::memcmp(header.magic, kMagic, sizeof(kMagic)) != 0 || header.tableSize < header.keyCount)
+	{
+		return false;
+	}
+	if (header.keyCount > 0 && header.bucketCount == 0)
+	{
+		return false;
+	}
+
+	keyCount = header.keyCount;
+	tableSize = header.tableSize;
+	bucketCount = header.bucketCount;
+	seed = header.seed;
+	if (GetSerializedSize() > aSize)
+	{
+		Clear();
+		return false;
+	}
+	const unsigned char* cursor = aData + sizeof(header);
+	pilots = reinterpret_cast<const uint16_t*>(cursor);
+	cursor += AlignTo8(sizeof(uint16_t) * bucketCount);
+	remap = reinterpret_cast<const uint32_t*>(cursor);
+
+	// Lookup returns remap entries as slots, so each must be one of the keyCount slots
+	for (uint32_t i = 0; i < tableSize - keyCount; i++)
+	{
+		if (remap[i] >= keyCount)
+		{
+			Clear();
+			return false;
+		}
+	}
+	return true;
+}
+
+void TMinimalPerfectHash::Clear()
+{
+	seed = 0;
+	keyCount = 0;
+	tableSize = 0;
+	bucketCount = 0;
+	pilotStorage.Clear();
+	pilotStorage.ShrinkToFit();
+	remapStorage.Clear();
+	remapStorage.ShrinkToFit();
+	pilots = nullptr;
+	remap = nullptr;
+}
@@ -0,0 +1,83 @@
+// PerfectHash.h
+#pragma once
+#ifndef PERFECT_HASH_H
+#define PERFECT_HASH_H
+
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+#include <string_view>
+#include "ArrayWrapper.hpp"
+
+/**
+ * @brief A minimal perfect hash function over a fixed set of string keys.
+ * Maps each of the n build keys to a distinct slot in [0, n) with one hash, one 16-bit "pilot"
+ * read and (rarely) one remap read, which is about 4.5 bits of metadata per key.
+ * Built CHD/PTHash style: keys are hashed into buckets, and for each bucket (largest first) we search
+ * for a pilot value that sends all of its keys to free slots.
+ * Keys outside the build set also map to some slot, so callers must verify the hit
+ * (e.g. compare the stored name).
+ */
+class TMinimalPerfectHash
+{
+private:
+	uint64_t seed;
+	uint32_t keyCount;
+	uint32_t tableSize;   // Slightly larger than keyCount so pilots are found quickly
+	uint32_t bucketCount;
+
+	// Owned storage after Build(); empty when attached to external memory
+	TArrayWrapper<uint16_t> pilotStorage;
+	TArrayWrapper<uint32_t> remapStorage;
+
+	// Views used by Lookup(): point into the owned storage or into a mapped file
+	const uint16_t* pilots;
+	const uint32_t* remap; // Slots >= keyCount are redirected to the free slots below keyCount
+
+	uint32_t BucketOf(uint64_t aHash) const;
+	uint64_t SlotOf(uint64_t aHash, uint16_t aPilot) const;
+	bool TryBuild(const uint64_t* aHashes);
+
+public:
+	TMinimalPerfectHash();
+
+	// Views may point into the object's own storage, so copies would dangle
+	TMinimalPerfectHash(const TMinimalPerfectHash&) = delete;
+	TMinimalPerfectHash& operator=(const TMinimalPerfectHash&) = delete;
+
+	/**
+	 * @brief Builds the function for aCount distinct keys.
+	 * @return False if the keys contain duplicates (no perfect function exists).
+	 */
+	bool Build(const std::string_view* aKeys, int aCount);
+
+	/**
+	 * @brief Returns the slot in [0, key count) for aKey, or -1 if the function is empty.
+	 */
+	int Lookup(std::string_view aKey) const;
+
+	int GetKeyCount() const { return static_cast<int>(keyCount); }
+
+	/**
+	 * @brief Metadata size divided by the key count.
+	 */
+	double GetBitsPerKey() const;
+
+	/**
+	 * @brief Number of bytes Serialize() writes (a multiple of 8).
+	 */
+	std::size_t GetSerializedSize() const;
+
+	void Serialize(std::ostream& aOut) const;
+
+	/**
+	 * @brief Uses a serialized function in place (e.g. inside a TMappedFile) without copying it.
+	 * The memory must stay valid and unchanged while this object is used.
+	 * @return False if the data is not a valid serialized function (including remap entries outside [0, key count)).
+	 */
+	bool Attach(const unsigned char* aData, std::size_t aSize);
+
+	void Clear();
+};
+
+#endif // PERFECT_HASH_H
@@ -3,95 +3,108 @@
 #define PRIORITY_QUEUE_HPP
 
 #include <stdexcept>
+#include <utility>
+#include "ArrayWrapper.hpp"
 
 /**
- * @brief A generic Min-Heap implementation.
+ * @brief A generic d-ary Min-Heap implementation.
  * Stores items of type T, prioritized by a float value (lower is better).
+ * Priorities and payloads live in separate arrays, so a sift only walks the packed float keys
+ * and moves a payload once per level. With Arity 4 or 8 the children of a node share a cache line
+ * and the heap is half or a third as deep as a binary heap.
  */
-template <typename T>
+template <typename T, int Arity = 2>
 class TPriorityQueue {
-private:
-	struct THeapNode {
-		T data;
-		float priority;
-	};
+	static_assert(Arity >= 2, "TPriorityQueue: Arity must be at least 2");
 
-	THeapNode* heapArray;
-	int count;
-	int capacity;
+private:
+	TArrayWrapper<float> priorities; // Heap slot -> priority
+	TArrayWrapper<T> items;          // Heap slot -> payload
 
 	/**
-	 * @brief Swaps two nodes in the heap array.
+	 * @brief Moves the hole at aSlot up until aPriority fits, then returns the final slot.
+	 * The caller writes the new item into the returned slot.
 	 */
-	void Swap(int aIndexA, int aIndexB) {
-		THeapNode temp = heapArray[aIndexA];
-		heapArray[aIndexA] = heapArray[aIndexB];
-		heapArray[aIndexB] = temp;
+	int SiftUpHole(int aSlot, float aPriority) {
+		float* keys = priorities.GetData();
+		T* data = items.GetData();
+		while (aSlot > 0) {
+			int parentSlot = (aSlot - 1) / Arity;
+			if (!(aPriority < keys[parentSlot])) {
+				break;
+			}
+			keys[aSlot] = keys[parentSlot];
+			data[aSlot] = std::move(data[parentSlot]);
+			aSlot = parentSlot;
+		}
+		return aSlot;
 	}
 
 	/**
-	 * @brief Restores heap property by moving an item up.
+	 * @brief Moves the hole at aSlot down until aPriority fits among aCount slots, then returns the final slot.
 	 */
-	void HeapifyUp(int aIndex) {
-		if (aIndex == 0) return;
-
-		int parentIndex = (aIndex - 1) / 2;
-
-		// If current node is smaller than parent (Min-Heap), swap
-		if (heapArray[aIndex].priority < heapArray[parentIndex].priority) {
-			Swap(aIndex, parentIndex);
-			HeapifyUp(parentIndex);
+	int SiftDownHole(int aSlot, float aPriority, int aCount) {
+		float* keys = priorities.GetData();
+		T* data = items.GetData();
+		while (true) {
+			int firstChild = aSlot * Arity + 1;
+			if (firstChild >= aCount) {
+				break;
+			}
+			int lastChild = firstChild + Arity;
+			if (lastChild > aCount) {
+				lastChild = aCount;
+			}
+			int smallest = firstChild;
+			for (int child = firstChild + 1; child < lastChild; child++) {
+				if (keys[child] < keys[smallest]) {
+					smallest = child;
+				}
+			}
+			if (!(keys[smallest] < aPriority)) {
+				break;
+			}
+			keys[aSlot] = keys[smallest];
+			data[aSlot] = std::move(data[smallest]);
+			aSlot = smallest;
 		}
+		return aSlot;
 	}
 
+public:
 	/**
-	 * @brief Restores heap property by moving an item down.
+	 * @param aCapacity Initial number of slots to reserve. The heap grows past it when needed.
 	 */
-	void HeapifyDown(int aIndex) {
-		int leftChild = 2 * aIndex + 1;
-		int rightChild = 2 * aIndex + 2;
-		int smallest = aIndex;
-
-		if (leftChild < count && heapArray[leftChild].priority < heapArray[smallest].priority) {
-			smallest = leftChild;
-		}
-
-		if (rightChild < count && heapArray[rightChild].priority < heapArray[smallest].priority) {
-			smallest = rightChild;
-		}
-
-		if (smallest != aIndex) {
-			Swap(aIndex, smallest);
-			HeapifyDown(smallest);
-		}
+	explicit TPriorityQueue(int aCapacity = 0)
+		: priorities(aCapacity), items(aCapacity) {
 	}
 
-public:
-	TPriorityQueue(int aCapacity) : count(0), capacity(aCapacity) {
-		heapArray = new THeapNode[aCapacity];
+	bool IsEmpty() const {
+		return priorities.IsEmpty();
 	}
 
-	~TPriorityQueue() {
-		delete[] heapArray;
+	int GetCount() const {
+		return priorities.GetCount();
 	}
 
-	bool IsEmpty() const {
-		return count == 0;
+	void Enqueue(T aData, float aPriority) {
+		// Open a hole at the end (holding a copy, so T needs no default constructor), then bubble it up
+		int slot = priorities.GetCount();
+		priorities.Add(aPriority);
+		items.Add(aData);
+		slot = SiftUpHole(slot, aPriority);
+		priorities[slot] = aPriority;
+		items[slot] = std::move(aData);
 	}
 
-	void Enqueue(T aData, float aPriority) {
-		if (count >= capacity) {
-			// In a real app, we would resize. Here we assume strict bounds.
-			throw std::overflow_error("Priority Queue Overflow");
+	/**
+	 * @brief O(1) look at the lowest priority without removing it.
+	 */
+	float PeekPriority() const {
+		if (IsEmpty()) {
+			throw std::underflow_error("Priority Queue Underflow");
 		}
-
-		// Insert at end
-		heapArray[count].data = aData;
-		heapArray[count].priority = aPriority;
-
-		// Bubble up
-		HeapifyUp(count);
-		count++;
+		return priorities[0];
 	}
 
 	T Dequeue() {
@@ -99,19 +112,20 @@ public:
 			throw std::underflow_error("Priority Queue Underflow");
 		}
 
-		T result = heapArray[0].data;
-
-		// Move last element to root
-		heapArray[0] = heapArray[count - 1];
-		count--;
+		T result = std::move(items[0]);
 
-		// Bubble down
+		// Take the last element out and sift the root hole down to where it fits
+		float lastPriority = priorities.RemoveLast();
+		T lastItem = items.RemoveLast();
+		int count = priorities.GetCount();
 		if (count > 0) {
-			HeapifyDown(0);
+			int slot = SiftDownHole(0, lastPriority, count);
+			priorities[slot] = lastPriority;
+			items[slot] = std::move(lastItem);
 		}
 
 		return result;
 	}
 };
 
-#endif // PRIORITY_QUEUE_HPP
\ No newline at end of file
+#endif // PRIORITY_QUEUE_HPP
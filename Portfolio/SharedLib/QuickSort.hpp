@@ -1,22 +1,23 @@
 #pragma once
+#include <utility>
 #include "ArrayWrapper.hpp"
-
-template <typename T>
-using FCompareFunction = bool(*)(const T, const T);
+#include "CompareFunction.hpp"
 
 template <typename T>
 class TQuickSort
 {
 private:
+	// Ranges at or below this size are finished with insertion sort during selection
+	static constexpr int kSmallRange = 16;
+
 	/**
 	 * @brief Swaps two items in the array.
 	*/
-	static void Swap(TArrayWrapper<T>& array, int i, int j)
+	static void Swap(TArrayWrapper<T>& aArray, int i, int j)
 	{
-		T temp = array[i];
-		array[i] = array[j];
-		array[j] = temp;
+		std::swap(aArray[i], aArray[j]);
 	}
+
 	/**
 	 * @brief Partitions the array (Lomuto partition scheme).
 	 */
@@ -26,7 +27,7 @@ private:
 		int aHigh,
 		FCompareFunction<T> aCompareFunc
 	) {
-		T pivot = (*aArray)[aHigh];
+		T pivot = aArray[aHigh];
 		int i = aLow; // Index of smaller element
 		for (int j = aLow; j < aHigh; j++)
 		{
@@ -46,7 +47,7 @@ private:
  * @brief Recursive quick sort helper.
  */
 	static void QuickSort(
-		TArrayWrapper<T>* aArray,
+		TArrayWrapper<T>& aArray,
 		int aLow,
 		int aHigh,
 		FCompareFunction<T> aCompare
@@ -61,6 +62,107 @@ private:
 			QuickSort(aArray, pi + 1, aHigh, aCompare);
 		}
 	}
+
+	/**
+	 * @brief Moves the median of first/middle/last to aHigh so Partition uses it as pivot.
+	 * Keeps sorted and reverse-sorted input from degrading selection to O(n^2).
+	 */
+	static void MedianOfThreeToHigh(TArrayWrapper<T>& aArray, int aLow, int aHigh, FCompareFunction<T> aCompare)
+	{
+		int mid = aLow + (aHigh - aLow) / 2;
+		if (aCompare(aArray[mid], aArray[aLow])) Swap(aArray, mid, aLow);
+		if (aCompare(aArray[aHigh], aArray[aLow])) Swap(aArray, aHigh, aLow);
+		if (aCompare(aArray[mid], aArray[aHigh])) Swap(aArray, mid, aHigh);
+		// aArray[aHigh] now holds the median of the three samples
+	}
+
+	static void InsertionSort(TArrayWrapper<T>& aArray, int aLow, int aHigh, FCompareFunction<T> aCompare)
+	{
+		for (int i = aLow + 1; i <= aHigh; i++)
+		{
+			T item = std::move(aArray[i]);
+			int j = i - 1;
+			while (j >= aLow && !aCompare(aArray[j], item))
+			{
+				aArray[j + 1] = std::move(aArray[j]);
+				j--;
+			}
+			aArray[j + 1] = std::move(item);
+		}
+	}
+
+	/**
+	 * @brief Restores the max-heap property (by aCompare) of the heap stored in [aBase, aBase + aCount).
+	 */
+	static void SiftDown(TArrayWrapper<T>& aArray, int aBase, int aCount, int aIndex, FCompareFunction<T> aCompare)
+	{
+		while (true)
+		{
+			int largest = aIndex;
+			int left = 2 * aIndex + 1;
+			int right = left + 1;
+			if (left < aCount && !aCompare(aArray[aBase + left], aArray[aBase + largest])) largest = left;
+			if (right < aCount && !aCompare(aArray[aBase + right], aArray[aBase + largest])) largest = right;
+			if (largest == aIndex) return;
+			Swap(aArray, aBase + aIndex, aBase + largest);
+			aIndex = largest;
+		}
+	}
+
+	/**
+	 * @brief Worst-case O(n log k) fallback used when introselect exceeds its depth budget.
+	 * Keeps the (aNth - aLow + 1) smallest items of [aLow, aHigh] in a max-heap, then puts the heap top at aNth.
+	 */
+	static void HeapSelect(TArrayWrapper<T>& aArray, int aLow, int aHigh, int aNth, FCompareFunction<T> aCompare)
+	{
+		int heapCount = aNth - aLow + 1;
+		for (int i = heapCount / 2 - 1; i >= 0; i--)
+		{
+			SiftDown(aArray, aLow, heapCount, i, aCompare);
+		}
+		for (int i = aNth + 1; i <= aHigh; i++)
+		{
+			// Only strictly smaller items displace the current k-th candidate
+			if (!aCompare(aArray[aLow], aArray[i]))
+			{
+				Swap(aArray, aLow, i);
+				SiftDown(aArray, aLow, heapCount, 0, aCompare);
+			}
+		}
+		Swap(aArray, aLow, aNth);
+	}
+
+	static int FloorLog2(int aValue)
+	{
+		int result = 0;
+		while (aValue > 1)
+		{
+			aValue >>= 1;
+			result++;
+		}
+		return result;
+	}
+
+	static void IntroSelect(TArrayWrapper<T>& aArray, int aLow, int aHigh, int aNth, FCompareFunction<T> aCompare)
+	{
+		int depthBudget = 2 * FloorLog2(aHigh - aLow + 1);
+		while (aHigh - aLow + 1 > kSmallRange)
+		{
+			if (depthBudget-- == 0)
+			{
+				HeapSelect(aArray, aLow, aHigh, aNth, aCompare);
+				return;
+			}
+			MedianOfThreeToHigh(aArray, aLow, aHigh, aCompare);
+			int pi = Partition(aArray, aLow, aHigh, aCompare);
+			if (pi == aNth) return;
+			// Only descend into the side that contains aNth
+			if (aNth < pi) aHigh = pi - 1;
+			else aLow = pi + 1;
+		}
+		InsertionSort(aArray, aLow, aHigh, aCompare);
+	}
+
 public:
 	/**
 	 * @brief Public static Sort method for TArrayWrapper.
@@ -69,6 +171,34 @@ public:
 		if (aArray == nullptr || aArray->GetCount() < 2) {
 			return; // No need to sort
 		}
-		QuickSort(aArray, 0, aArray->GetCount() - 1, aCompare);
+		QuickSort(*aArray, 0, aArray->GetCount() - 1, aCompare);
+	}
+
+	/**
+	 * @brief Introselect: places the item that belongs at index aNth in sorted order there, in O(n) average
+	 * and O(n log n) worst case. Items before aNth compare before or equal to it, items after compare after or equal.
+	 * The order within each side is unspecified.
+	 */
+	static void SelectNth(TArrayWrapper<T>* aArray, int aNth, FCompareFunction<T> aCompare) {
+		if (aArray == nullptr || aNth < 0 || aNth >= aArray->GetCount() || aArray->GetCount() < 2) {
+			return; // Nothing to select
+		}
+		IntroSelect(*aArray, 0, aArray->GetCount() - 1, aNth, aCompare);
+	}
+
+	/**
+	 * @brief Sorts only the first aK items: after the call [0, aK) holds the aK smallest items in order,
+	 * the rest of the array is left unordered. O(n + k log k) on average instead of O(n log n).
+	 */
+	static void PartialSort(TArrayWrapper<T>* aArray, int aK, FCompareFunction<T> aCompare) {
+		if (aArray == nullptr || aK <= 0) {
+			return;
+		}
+		if (aK >= aArray->GetCount()) {
+			Sort(aArray, aCompare);
+			return;
+		}
+		IntroSelect(*aArray, 0, aArray->GetCount() - 1, aK - 1, aCompare);
+		QuickSort(*aArray, 0, aK - 2, aCompare);
 	}
-};
\ No newline at end of file
+};
@@ -0,0 +1,125 @@
+#pragma once
+#ifndef RADIX_HEAP_HPP
+#define RADIX_HEAP_HPP
+
+#include <cstdint>
+#include <stdexcept>
+#include <utility>
+#include "ArrayWrapper.hpp"
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+/**
+ * @brief A monotone radix heap for unsigned integer keys.
+ * Monotone means every pushed key must be >= the last key popped, which is what Dijkstra with
+ * non-negative integer weights produces. Items live in 33 buckets keyed by the highest bit in which
+ * they differ from the last popped key, so Push is O(1) and each item is moved at most 32 times
+ * over its lifetime (amortised O(log C) per pop, C = largest edge weight).
+ */
+template <typename T>
+class TRadixHeap {
+private:
+	static constexpr int kBucketCount = 33;
+
+	struct TEntry {
+		uint32_t key;
+		T data;
+	};
+
+	TArrayWrapper<TEntry> buckets[kBucketCount];
+	uint32_t lastKey; // Key of the last popped item (the current minimum bound)
+	int count;
+
+	/**
+	 * @brief Number of significant bits in aValue (0 for 0).
+	 */
+	static int BitWidth(uint32_t aValue) {
+		if (aValue == 0) {
+			return 0;
+		}
+#if defined(_MSC_VER)
+		unsigned long index = 0;
+		_BitScanReverse(&index, aValue);
+		return static_cast<int>(index) + 1;
+#else
+		return 32 - __builtin_clz(aValue);
+#endif
+	}
+
+	int BucketFor(uint32_t aKey) const {
+		return BitWidth(aKey ^ lastKey);
+	}
+
+	/**
+	 * @brief Refills bucket 0 from the first non-empty bucket, raising lastKey to that bucket's minimum.
+	 */
+	void Redistribute() {
+		int source = 1;
+		while (buckets[source].IsEmpty()) {
+			source++;
+		}
+		TArrayWrapper<TEntry>& from = buckets[source];
+		uint32_t minKey = from[0].key;
+		for (const TEntry& entry : from) {
+			if (entry.key < minKey) {
+				minKey = entry.key;
+			}
+		}
+		lastKey = minKey;
+		// Every entry lands in a strictly lower bucket relative to the new lastKey
+		while (!from.IsEmpty()) {
+			TEntry entry = from.RemoveLast();
+			buckets[BucketFor(entry.key)].Add(std::move(entry));
+		}
+	}
+
+public:
+	TRadixHeap() : lastKey(0), count(0) {}
+
+	bool IsEmpty() const {
+		return count == 0;
+	}
+
+	int GetCount() const {
+		return count;
+	}
+
+	/**
+	 * @brief Removes every item and resets the minimum bound to 0, keeping the buckets for reuse.
+	 */
+	void Clear() {
+		for (TArrayWrapper<TEntry>& bucket : buckets) {
+			bucket.Clear();
+		}
+		lastKey = 0;
+		count = 0;
+	}
+
+	void Enqueue(T aData, uint32_t aKey) {
+		if (aKey < lastKey) {
+			throw std::invalid_argument("Radix Heap: Key is smaller than the last popped key");
+		}
+		buckets[BucketFor(aKey)].Add(TEntry{ aKey, std::move(aData) });
+		count++;
+	}
+
+	/**
+	 * @brief Removes an item with the smallest key.
+	 * @param aOutKey Receives the key of the removed item.
+	 */
+	T Dequeue(uint32_t& aOutKey) {
+		if (IsEmpty()) {
+			throw std::underflow_error("Radix Heap Underflow");
+		}
+		if (buckets[0].IsEmpty()) {
+			Redistribute();
+		}
+		count--;
+		aOutKey = lastKey;
+		return buckets[0].RemoveLast().data;
+	}
+};
+
+#endif // RADIX_HEAP_HPP
@@ -0,0 +1,549 @@
+#pragma once
+#ifndef RADIX_TRIE_HPP
+#define RADIX_TRIE_HPP
+
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <string_view>
+#include <utility>
+#include "ArrayWrapper.hpp"
+
+/**
+ * @brief A string-keyed compressed radix trie with adaptive node sizes (after the Adaptive Radix Tree).
+ * Keys that share a beginning share the path for it, and a chain of single-child nodes is collapsed
+ * into one node that stores the skipped bytes as its prefix. Each node only makes room for the
+ * children it has: 0, 4, 16, 48 or 256, and grows to the next size when it fills up.
+ * This makes prefix queries ("every name starting with Ber") a walk down at most the prefix length,
+ * followed by an in-order walk of one subtree. Results come out sorted by byte value.
+ * Note: Does not assume ownership of T (if T is a pointer), like TBinarySearchTable.
+ */
+template <typename T>
+class TRadixTrie {
+private:
+	enum class ENodeKind : uint8_t { Leaf, Node4, Node16, Node48, Node256 };
+
+	static constexpr uint32_t kInlinePrefix = 8;  // Prefixes up to this length need no extra allocation
+	static constexpr uint8_t kNoSlot = 0xFF;      // Empty entry in a Node48 index
+
+	struct TNode {
+		ENodeKind kind;
+		bool hasValue = false;   // True if a key ends at this node
+		uint16_t childCount = 0;
+		uint32_t prefixLength = 0;
+		union {
+			char inlineBytes[kInlinePrefix];
+			char* heapBytes;
+		} prefix;
+		T value{};
+
+		explicit TNode(ENodeKind aKind) : kind(aKind) {}
+
+		const char* PrefixData() const {
+			return prefixLength <= kInlinePrefix ? prefix.inlineBytes : prefix.heapBytes;
+		}
+	};
+
+	struct TLeaf : TNode {
+		TLeaf() : TNode(ENodeKind::Leaf) {}
+	};
+
+	// Node4 and Node16 keep their keys sorted so an in-order walk is a plain scan
+	struct TNode4 : TNode {
+		uint8_t keys[4];
+		TNode* children[4];
+		TNode4() : TNode(ENodeKind::Node4) {}
+	};
+
+	struct TNode16 : TNode {
+		uint8_t keys[16];
+		TNode* children[16];
+		TNode16() : TNode(ENodeKind::Node16) {}
+	};
+
+	// Node48 maps a byte to one of 48 child slots
+	struct TNode48 : TNode {
+		uint8_t slotOf[256];
+		TNode* children[48];
+		TNode48() : TNode(ENodeKind::Node48) {
+			std::memset(slotOf, kNoSlot, sizeof(slotOf));
+		}
+	};
+
+	struct TNode256 : TNode {
+		TNode* children[256] = {};
+		TNode256() : TNode(ENodeKind::Node256) {}
+	};
+
+	TNode* root;
+	int count;
+	std::size_t memoryUsage; // Bytes held by nodes and out-of-line prefixes
+
+	// --- Node Management ---
+
+	template <typename TKind>
+	TKind* NewNode() {
+		memoryUsage += sizeof(TKind);
+		return new TKind();
+	}
+
+	void FreeNode(TNode* aNode) {
+		SetPrefix(aNode, nullptr, 0);
+		switch (aNode->kind) {
+		case ENodeKind::Leaf: memoryUsage -= sizeof(TLeaf); delete static_cast<TLeaf*>(aNode); break;
+		case ENodeKind::Node4: memoryUsage -= sizeof(TNode4); delete static_cast<TNode4*>(aNode); break;
+		case ENodeKind::Node16: memoryUsage -= sizeof(TNode16); delete static_cast<TNode16*>(aNode); break;
+		case ENodeKind::Node48: memoryUsage -= sizeof(TNode48); delete static_cast<TNode48*>(aNode); break;
+		case ENodeKind::Node256: memoryUsage -= sizeof(TNode256); delete static_cast<TNode256*>(aNode); break;
+		}
+	}
+
+	/**
+	 * @brief Replaces a node's prefix. aBytes may point into the node's current prefix.
+	 */
+	void SetPrefix(TNode* aNode, const char* aBytes, uint32_t aLength) {
+		char* oldHeap = (aNode->prefixLength > kInlinePrefix) ? aNode->prefix.heapBytes : nullptr;
+		if (aLength > kInlinePrefix) {
+			char* bytes = new char[aLength];
+			std::memcpy(bytes, aBytes, aLength);
+			aNode->prefix.heapBytes = bytes;
+			memoryUsage += aLength;
+		}
+		else if (aLength > 0) {
+			std::memmove(aNode->prefix.inlineBytes, aBytes, aLength);
+		}
+		if (oldHeap != nullptr) {
+			memoryUsage -= aNode->prefixLength;
+			delete[] oldHeap;
+		}
+		aNode->prefixLength = aLength;
+	}
+
+	TNode* NewLeaf(std::string_view aRest, T&& aValue) {
+		TLeaf* leaf = NewNode<TLeaf>();
+		SetPrefix(leaf, aRest.data(), static_cast<uint32_t>(aRest.size()));
+		leaf->hasValue = true;
+		leaf->value = std::move(aValue);
+		count++;
+		return leaf;
+	}
+
+	/**
+	 * @brief Moves the prefix and value of aFrom into aTo (used when a node changes size).
+	 */
+	static void MoveHeader(TNode* aFrom, TNode* aTo) {
+		aTo->hasValue = aFrom->hasValue;
+		aTo->value = std::move(aFrom->value);
+		aTo->prefixLength = aFrom->prefixLength;
+		aTo->prefix = aFrom->prefix;
+		aFrom->prefixLength = 0; // aTo owns any heap prefix now
+	}
+
+	// --- Child Access ---
+
+	static TNode** FindChild(TNode* aNode, uint8_t aByte) {
+		switch (aNode->kind) {
+		case ENodeKind::Node4: {
+			TNode4* node = static_cast<TNode4*>(aNode);
+			for (int i = 0; i < node->childCount; i++) {
+				if (node->keys[i] == aByte) return &node->children[i];
+			}
+			return nullptr;
+		}
+		case ENodeKind::Node16: {
+			TNode16* node = static_cast<TNode16*>(aNode);
+			for (int i = 0; i < node->childCount && node->keys[i] <= aByte; i++) {
+				if (node->keys[i] == aByte) return &node->children[i];
+			}
+			return nullptr;
+		}
+		case ENodeKind::Node48: {
+			TNode48* node = static_cast<TNode48*>(aNode);
+			uint8_t slot = node->slotOf[aByte];
+			return slot == kNoSlot ? nullptr : &node->children[slot];
+		}
+		case ENodeKind::Node256: {
+			TNode256* node = static_cast<TNode256*>(aNode);
+			return node->children[aByte] != nullptr ? &node->children[aByte] : nullptr;
+		}
+		default:
+			return nullptr;
+		}
+	}
+
+	/**
+	 * @brief The child with the smallest key byte >= aFromByte, or nullptr. aOutByte receives its key byte.
+	 */
+	static TNode* NextChild(const TNode* aNode, int aFromByte, int& aOutByte) {
+		switch (aNode->kind) {
+		case ENodeKind::Node4:
+		case ENodeKind::Node16: {
+			const uint8_t* keys = (aNode->kind == ENodeKind::Node4)
+				? static_cast<const TNode4*>(aNode)->keys : static_cast<const TNode16*>(aNode)->keys;
+			TNode* const* children = (aNode->kind == ENodeKind::Node4)
+				? static_cast<const TNode4*>(aNode)->children : static_cast<const TNode16*>(aNode)->children;
+			for (int i = 0; i < aNode->childCount; i++) {
+				if (keys[i] >= aFromByte) {
+					aOutByte = keys[i];
+					return children[i];
+				}
+			}
+			return nullptr;
+		}
+		case ENodeKind::Node48: {
+			const TNode48* node = static_cast<const TNode48*>(aNode);
+			for (int b = aFromByte; b < 256; b++) {
+				if (node->slotOf[b] != kNoSlot) {
+					aOutByte = b;
+					return node->children[node->slotOf[b]];
+				}
+			}
+			return nullptr;
+		}
+		case ENodeKind::Node256: {
+			const TNode256* node = static_cast<const TNode256*>(aNode);
+			for (int b = aFromByte; b < 256; b++) {
+				if (node->children[b] != nullptr) {
+					aOutByte = b;
+					return node->children[b];
+				}
+			}
+			return nullptr;
+		}
+		default:
+			return nullptr;
+		}
+	}
+
+	template <typename TSmall>
+	static void InsertSorted(TSmall* aNode, uint8_t aByte, TNode* aChild) {
+		int at = aNode->childCount;
+		while (at > 0 && aNode->keys[at - 1] > aByte) {
+			aNode->keys[at] = aNode->keys[at - 1];
+			aNode->children[at] = aNode->children[at - 1];
+			at--;
+		}
+		aNode->keys[at] = aByte;
+		aNode->children[at] = aChild;
+		aNode->childCount++;
+	}
+
+	/**
+	 * @brief Adds a child under a byte that is not in use yet, growing the node (and updating *aLink) if it is full.
+	 */
+	void AddChild(TNode** aLink, uint8_t aByte, TNode* aChild) {
+		TNode* node = *aLink;
+		switch (node->kind) {
+		case ENodeKind::Leaf: {
+			TNode4* grown = NewNode<TNode4>();
+			MoveHeader(node, grown);
+			FreeNode(node);
+			*aLink = grown;
+			InsertSorted(grown, aByte, aChild);
+			return;
+		}
+		case ENodeKind::Node4: {
+			TNode4* small = static_cast<TNode4*>(node);
+			if (small->childCount < 4) {
+				InsertSorted(small, aByte, aChild);
+				return;
+			}
+			TNode16* grown = NewNode<TNode16>();
+			MoveHeader(small, grown);
+			std::memcpy(grown->keys, small->keys, 4);
+			std::memcpy(grown->children, small->children, sizeof(small->children));
+			grown->childCount = 4;
+			FreeNode(small);
+			*aLink = grown;
+			InsertSorted(grown, aByte, aChild);
+			return;
+		}
+		case ENodeKind::Node16: {
+			TNode16* small = static_cast<TNode16*>(node);
+			if (small->childCount < 16) {
+				InsertSorted(small, aByte, aChild);
+				return;
+			}
+			TNode48* grown = NewNode<TNode48>();
+			MoveHeader(small, grown);
+			for (int i = 0; i < 16; i++) {
+				grown->slotOf[small->keys[i]] = static_cast<uint8_t>(i);
+				grown->children[i] = small->children[i];
+			}
+			grown->childCount = 16;
+			FreeNode(small);
+			*aLink = grown;
+			AddChild(aLink, aByte, aChild);
+			return;
+		}
+		case ENodeKind::Node48: {
+			TNode48* medium = static_cast<TNode48*>(node);
+			if (medium->childCount < 48) {
+				// Slots fill in order and are never freed, so the next one is always free
+				medium->slotOf[aByte] = static_cast<uint8_t>(medium->childCount);
+				medium->children[medium->childCount] = aChild;
+				medium->childCount++;
+				return;
+			}
+			TNode256* grown = NewNode<TNode256>();
+			MoveHeader(medium, grown);
+			for (int b = 0; b < 256; b++) {
+				if (medium->slotOf[b] != kNoSlot) {
+					grown->children[b] = medium->children[medium->slotOf[b]];
+				}
+			}
+			grown->childCount = 48;
+			FreeNode(medium);
+			*aLink = grown;
+			AddChild(aLink, aByte, aChild);
+			return;
+		}
+		case ENodeKind::Node256: {
+			TNode256* large = static_cast<TNode256*>(node);
+			large->children[aByte] = aChild;
+			large->childCount++;
+			return;
+		}
+		}
+	}
+
+	/**
+	 * @brief Length of the common beginning of a node's prefix and aKey.
+	 */
+	static uint32_t MatchPrefix(const TNode* aNode, std::string_view aKey) {
+		const char* bytes = aNode->PrefixData();
+		uint32_t limit = aNode->prefixLength;
+		if (aKey.size() < limit) {
+			limit = static_cast<uint32_t>(aKey.size());
+		}
+		uint32_t i = 0;
+		while (i < limit && bytes[i] == aKey[i]) {
+			i++;
+		}
+		return i;
+	}
+
+	const TNode* FindNode(std::string_view aKey) const {
+		const TNode* node = root;
+		std::size_t depth = 0;
+		while (node != nullptr) {
+			std::string_view rest = aKey.substr(depth);
+			if (rest.size() < node->prefixLength
+				|| std::memcmp(node->PrefixData(), rest.data(), node->prefixLength) != 0) {
+				return nullptr;
+			}
+			depth += node->prefixLength;
+			if (depth == aKey.size()) {
+				return node->hasValue ? node : nullptr;
+			}
+			TNode** child = FindChild(const_cast<TNode*>(node), static_cast<uint8_t>(aKey[depth]));
+			if (child == nullptr) {
+				return nullptr;
+			}
+			node = *child;
+			depth++;
+		}
+		return nullptr;
+	}
+
+	void FreeAll() {
+		TArrayWrapper<TNode*> stack;
+		if (root != nullptr) stack.Add(root);
+		while (!stack.IsEmpty()) {
+			TNode* node = stack.RemoveLast();
+			int byte = 0;
+			for (TNode* child = NextChild(node, 0, byte); child != nullptr; child = NextChild(node, byte + 1, byte)) {
+				stack.Add(child);
+			}
+			FreeNode(node);
+		}
+		root = nullptr;
+		count = 0;
+	}
+
+public:
+	TRadixTrie() : root(nullptr), count(0), memoryUsage(0) {}
+
+	~TRadixTrie() {
+		FreeAll();
+	}
+
+	TRadixTrie(const TRadixTrie&) = delete;
+	TRadixTrie& operator=(const TRadixTrie&) = delete;
+
+	/**
+	 * @brief Inserts or updates a key.
+	 */
+	void Insert(std::string_view aKey, T aValue) {
+		TNode** link = &root;
+		std::size_t depth = 0;
+		while (true) {
+			TNode* node = *link;
+			if (node == nullptr) {
+				*link = NewLeaf(aKey.substr(depth), std::move(aValue));
+				return;
+			}
+			std::string_view rest = aKey.substr(depth);
+			uint32_t matched = MatchPrefix(node, rest);
+			if (matched < node->prefixLength) {
+				// The key leaves the compressed path part way: split it with a new node for the shared part
+				TNode4* split = NewNode<TNode4>();
+				SetPrefix(split, node->PrefixData(), matched);
+				uint8_t nodeByte = static_cast<uint8_t>(node->PrefixData()[matched]);
+				SetPrefix(node, node->PrefixData() + matched + 1, node->prefixLength - matched - 1);
+				InsertSorted(split, nodeByte, node);
+				*link = split;
+				if (matched == rest.size()) {
+					split->hasValue = true;
+					split->value = std::move(aValue);
+					count++;
+				}
+				else {
+					TNode* leaf = NewLeaf(rest.substr(matched + 1), std::move(aValue));
+					InsertSorted(split, static_cast<uint8_t>(rest[matched]), leaf);
+				}
+				return;
+			}
+			depth += matched;
+			if (depth == aKey.size()) {
+				if (!node->hasValue) {
+					node->hasValue = true;
+					count++;
+				}
+				// Key exists; update value
+				node->value = std::move(aValue);
+				return;
+			}
+			uint8_t byte = static_cast<uint8_t>(aKey[depth]);
+			TNode** child = FindChild(node, byte);
+			if (child == nullptr) {
+				AddChild(link, byte, NewLeaf(aKey.substr(depth + 1), std::move(aValue)));
+				return;
+			}
+			link = child;
+			depth++;
+		}
+	}
+
+	/**
+	 * @brief Returns a pointer to the stored value, or nullptr. Valid until the next insert.
+	 */
+	const T* Find(std::string_view aKey) const {
+		const TNode* node = FindNode(aKey);
+		return node != nullptr ? &node->value : nullptr;
+	}
+
+	/**
+	 * @brief TBinarySearchTable-compatible lookup.
+	 */
+	bool Search(std::string_view aKey, T& aOutValue) const {
+		const T* value = Find(aKey);
+		if (value == nullptr) {
+			return false;
+		}
+		aOutValue = *value;
+		return true;
+	}
+
+	bool Contains(std::string_view aKey) const {
+		return FindNode(aKey) != nullptr;
+	}
+
+	/**
+	 * @brief Calls aVisit(key, value) for keys that start with aPrefix, in sorted order, as they are found.
+	 * Stops after aLimit keys (aLimit < 0 = no limit) or when aVisit returns false.
+	 * @return The number of keys visited.
+	 */
+	template <typename TVisitor>
+	int ForEachWithPrefix(std::string_view aPrefix, int aLimit, TVisitor&& aVisit) const {
+		// 1. Walk down to the highest node whose subtree holds every match
+		const TNode* node = root;
+		std::size_t depth = 0;
+		while (node != nullptr) {
+			std::string_view rest = aPrefix.substr(depth);
+			uint32_t matched = MatchPrefix(node, rest);
+			if (matched == rest.size()) {
+				break; // The prefix ends inside (or right after) this node's path
+			}
+			if (matched < node->prefixLength) {
+				return 0;
+			}
+			depth += matched;
+			TNode** child = FindChild(const_cast<TNode*>(node), static_cast<uint8_t>(aPrefix[depth]));
+			node = (child != nullptr) ? *child : nullptr;
+			depth++;
+		}
+		if (node == nullptr || aLimit == 0) {
+			return 0;
+		}
+
+		// 2. In-order walk of that subtree with an explicit stack
+		struct TFrame {
+			const TNode* node;
+			int nextByte;          // Smallest child byte not visited yet
+			std::size_t keyLength; // Key length before this node's prefix
+		};
+		std::string key(aPrefix.substr(0, depth));
+		TArrayWrapper<TFrame> stack;
+		stack.Add(TFrame{ node, -1, key.size() });
+		int visited = 0;
+		while (!stack.IsEmpty()) {
+			TFrame& frame = stack[stack.GetCount() - 1];
+			if (frame.nextByte < 0) {
+				// First time here: extend the key and report the node's own entry
+				key.resize(frame.keyLength);
+				key.append(frame.node->PrefixData(), frame.node->prefixLength);
+				frame.nextByte = 0;
+				if (frame.node->hasValue) {
+					visited++;
+					if (!aVisit(static_cast<const std::string&>(key), frame.node->value) || visited == aLimit) {
+						break;
+					}
+				}
+			}
+			int byte = 0;
+			const TNode* child = (frame.nextByte < 256) ? NextChild(frame.node, frame.nextByte, byte) : nullptr;
+			if (child == nullptr) {
+				stack.RemoveLast();
+				continue;
+			}
+			frame.nextByte = byte + 1;
+			std::size_t childKeyLength = frame.keyLength + frame.node->prefixLength + 1;
+			key.resize(childKeyLength - 1);
+			key.push_back(static_cast<char>(byte));
+			stack.Add(TFrame{ child, -1, childKeyLength });
+		}
+		return visited;
+	}
+
+	/**
+	 * @brief Collects up to aLimit keys that start with aPrefix, in sorted order.
+	 */
+	int CollectWithPrefix(std::string_view aPrefix, int aLimit, TArrayWrapper<std::string>* aOutKeys) const {
+		return ForEachWithPrefix(aPrefix, aLimit, [aOutKeys](const std::string& aKey, const T&) {
+			aOutKeys->Add(aKey);
+			return true;
+		});
+	}
+
+	int GetCount() const {
+		return count;
+	}
+
+	bool IsEmpty() const {
+		return count == 0;
+	}
+
+	/**
+	 * @brief Bytes held by the trie's nodes and prefixes (excluding anything T points to).
+	 */
+	std::size_t GetMemoryUsage() const {
+		return memoryUsage;
+	}
+
+	void Clear() {
+		FreeAll();
+	}
+};
+
+#endif // RADIX_TRIE_HPP
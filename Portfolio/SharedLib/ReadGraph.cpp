@@ -33,6 +33,16 @@ void readGraphFromFile(const std::string& aFilename, FNodeRead aOnNodeRead, FEdg
 
 	while (keepReading && std::getline(file, line))
 	{
+		// Files saved by Notepad start with a UTF-8 BOM, which would hide the first header
+		if (line.size() >= 3 && line.compare(0, 3, "\xEF\xBB\xBF") == 0)
+		{
+			line.erase(0, 3);
+		}
+		// Tolerate Windows line endings
+		if (!line.empty() && line.back() == '\r')
+		{
+			line.pop_back();
+		}
 		if (line.empty()) continue;
 
 		if (line[0] == '[')
@@ -0,0 +1,109 @@
+#include "ThreadPool.h"
+
+TThreadPool::TThreadPool(int aThreadCount)
+	: body(nullptr), itemCount(0), chunkSize(1), nextIndex(0), jobNumber(0), busyWorkers(0), isStopping(false)
+{
+	if (aThreadCount <= 0)
+	{
+		aThreadCount = DefaultThreadCount();
+	}
+	for (int i = 1; i < aThreadCount; i++)
+	{
+		workers.emplace_back(&TThreadPool::WorkerLoop, this, i);
+	}
+}
+
+TThreadPool::~TThreadPool()
+{
+	{
+		std::lock_guard<std::mutex> guard(lock);
+		isStopping = true;
+	}
+	wake.notify_all();
+	for (std::thread& worker : workers)
+	{
+		worker.join();
+	}
+}
+
+int TThreadPool::DefaultThreadCount()
+{
+	int count = static_cast<int>(std::thread::hardware_concurrency());
+	return (count > 0) ? count : 1;
+}
+
+void TThreadPool::WorkerLoop(int aThreadIndex)
+{
+	uint64_t lastJob = 0;
+	std::unique_lock<std::mutex> guard(lock);
+	while (true)
+	{
+		wake.wait(guard, [&]() { return isStopping || jobNumber != lastJob; });
+		if (isStopping)
+		{
+			return;
+		}
+		lastJob = jobNumber;
+
+		guard.unlock();
+		RunChunks(aThreadIndex);
+		guard.lock();
+
+		busyWorkers--;
+		if (busyWorkers == 0)
+		{
+			finished.notify_one();
+		}
+	}
+}
+
+void TThreadPool::RunChunks(int aThreadIndex)
+{
+	while (true)
+	{
+		int first = nextIndex.fetch_add(chunkSize, std::memory_order_relaxed);
+		if (first >= itemCount)
+		{
+			return;
+		}
+		int last = (itemCount - first > chunkSize) ? first + chunkSize : itemCount;
+		for (int i = first; i < last; i++)
+		{
+			(*body)(i, aThreadIndex);
+		}
+	}
+}
+
+void TThreadPool::ParallelFor(int aCount, const FParallelBody& aBody, int aChunkSize)
+{
+	if (aCount <= 0)
+	{
+		return;
+	}
+	if (workers.empty())
+	{
+		for (int i = 0; i < aCount; i++)
+		{
+			aBody(i, 0);
+		}
+		return;
+	}
+
+	{
+		// The job fields are published under the lock; workers read them after waking on it
+		std::lock_guard<std::mutex> guard(lock);
+		body = &aBody;
+		itemCount = aCount;
+		chunkSize = (aChunkSize > 0) ? aChunkSize : 1;
+		nextIndex.store(0, std::memory_order_relaxed);
+		busyWorkers = static_cast<int>(workers.size());
+		jobNumber++;
+	}
+	wake.notify_all();
+
+	RunChunks(0);
+
+	std::unique_lock<std::mutex> guard(lock);
+	finished.wait(guard, [&]() { return busyWorkers == 0; });
+	body = nullptr;
+}
@@ -0,0 +1,72 @@
+// ThreadPool.h
+#pragma once
+#ifndef THREAD_POOL_H
+#define THREAD_POOL_H
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/**
+ * @brief A fixed set of worker threads for data-parallel loops.
+ * The threads are started once and sleep between jobs, so code that runs many parallel loops
+ * (one per source, one per matrix phase) does not pay for creating threads every time.
+ * ParallelFor hands out indices in chunks from a shared counter, so uneven items balance out.
+ * The calling thread works too: a pool of N threads starts N - 1 workers.
+ */
+class TThreadPool
+{
+public:
+	// Loop body: aIndex is the item, aThreadIndex in [0, GetThreadCount()) selects per-thread scratch state
+	typedef std::function<void(int aIndex, int aThreadIndex)> FParallelBody;
+
+private:
+	std::vector<std::thread> workers;
+	std::mutex lock;
+	std::condition_variable wake;     // Workers wait here for the next job
+	std::condition_variable finished; // ParallelFor waits here for the workers
+	const FParallelBody* body;
+	int itemCount;
+	int chunkSize;
+	std::atomic<int> nextIndex;
+	uint64_t jobNumber;  // Bumped per job, so a worker runs each job once
+	int busyWorkers;
+	bool isStopping;
+
+	void WorkerLoop(int aThreadIndex);
+
+	/**
+	 * @brief Claims chunks of the current job until none are left.
+	 */
+	void RunChunks(int aThreadIndex);
+
+public:
+	/**
+	 * @param aThreadCount Threads including the caller (0 = one per hardware thread).
+	 */
+	explicit TThreadPool(int aThreadCount = 0);
+	~TThreadPool();
+
+	TThreadPool(const TThreadPool&) = delete;
+	TThreadPool& operator=(const TThreadPool&) = delete;
+
+	int GetThreadCount() const { return static_cast<int>(workers.size()) + 1; }
+
+	/**
+	 * @brief Calls aBody(i, threadIndex) for every i in [0, aCount) and returns when all calls are done.
+	 * One ParallelFor at a time; aBody must not throw.
+	 * @param aChunkSize Indices claimed per step; larger chunks suit many cheap items.
+	 */
+	void ParallelFor(int aCount, const FParallelBody& aBody, int aChunkSize = 1);
+
+	/**
+	 * @brief Hardware threads, or 1 if that is unknown.
+	 */
+	static int DefaultThreadCount();
+};
+
+#endif // THREAD_POOL_H
@@ -0,0 +1,99 @@
+#pragma once
+#ifndef TOP_K_HPP
+#define TOP_K_HPP
+
+#include <utility>
+#include "LinkedList.hpp"
+#include "ArrayWrapper.hpp"
+#include "CompareFunction.hpp"
+
+/**
+ * @brief Streaming "first K in sorted order" selection for TLinkedList.
+ * Walks the list once and keeps only the K best items in a bounded max-heap,
+ * so the cost is O(n log k) time and O(k) memory instead of sorting the whole list.
+ */
+template <typename T>
+class TTopK
+{
+private:
+	/**
+	 * @brief Restores the max-heap property (the "worst" kept item on top) from aIndex downwards.
+	 */
+	static void SiftDown(TArrayWrapper<T>& aHeap, int aCount, int aIndex, FCompareFunction<T> aCompare)
+	{
+		while (true)
+		{
+			int largest = aIndex;
+			int left = 2 * aIndex + 1;
+			int right = left + 1;
+			if (left < aCount && !aCompare(aHeap[left], aHeap[largest])) largest = left;
+			if (right < aCount && !aCompare(aHeap[right], aHeap[largest])) largest = right;
+			if (largest == aIndex) return;
+			std::swap(aHeap[aIndex], aHeap[largest]);
+			aIndex = largest;
+		}
+	}
+
+public:
+	/**
+	 * @brief Collects the aK first items of aList (in aCompare order) into aOut, sorted.
+	 * @param aList The list to scan. It is not modified.
+	 * @param aK How many items to keep.
+	 * @param aCompare Returns true if the first item belongs before (or ties with) the second.
+	 * @param aOut An empty array; receives the result in sorted order.
+	 * @return The number of items written (min(aK, list count)).
+	 */
+	static int Select(const TLinkedList<T>* aList, int aK, FCompareFunction<T> aCompare, TArrayWrapper<T>* aOut)
+	{
+		if (aList == nullptr || aOut == nullptr || aK <= 0) {
+			return 0;
+		}
+		TArrayWrapper<T>& heap = *aOut;
+		int heapCount = 0;
+
+		TLinkedListNode<T>* current = aList->GetHead()->GetNext();
+		TLinkedListNode<T>* tail = aList->GetTail();
+		while (current != tail)
+		{
+			if (heapCount < aK)
+			{
+				heap.Add(current->GetData());
+				heapCount++;
+				if (heapCount == aK)
+				{
+					// Heap is full: heapify once, then only replace the top from here on
+					for (int i = heapCount / 2 - 1; i >= 0; i--)
+					{
+						SiftDown(heap, heapCount, i, aCompare);
+					}
+				}
+			}
+			else if (!aCompare(heap[0], current->GetData()))
+			{
+				// Strictly better than the worst item we are keeping
+				heap[0] = current->GetData();
+				SiftDown(heap, heapCount, 0, aCompare);
+			}
+			current = current->GetNext();
+		}
+
+		if (heapCount < aK)
+		{
+			// The list was shorter than aK, so the heap was never built
+			for (int i = heapCount / 2 - 1; i >= 0; i--)
+			{
+				SiftDown(heap, heapCount, i, aCompare);
+			}
+		}
+
+		// Heap sort the kept items into ascending order
+		for (int end = heapCount - 1; end > 0; end--)
+		{
+			std::swap(heap[0], heap[end]);
+			SiftDown(heap, end, 0, aCompare);
+		}
+		return heapCount;
+	}
+};
+
+#endif // TOP_K_HPP